@@ -49,9 +49,12 @@ function(nui_add_emscripten_target)
         list(APPEND CMAKE_PROGRAM_PATH "${CMAKE_BINARY_DIR}/_deps/emscripten-src/upstream/emscripten")
     endif()
 
+    # EMBED_FILES: Also compiles every file of the frontend build into include/index_files.hpp, to be served with
+    # Window::setVirtualHostNameToEmbeddedFiles. Combined with UNPACKED_MODE for the frontend, the wasm is then a
+    # file of its own, that the browser can compile while it streams in.
     cmake_parse_arguments(
         NUI_ADD_EMSCRIPTEN_TARGET_ARGS
-        ""
+        "EMBED_FILES"
         "TARGET;PREJS;SOURCE_DIR"
         "CMAKE_OPTIONS"
         ${ARGN}
@@ -83,6 +86,12 @@ function(nui_add_emscripten_target)
         set(ENABLE_BIN2HPP "yes")
     endif()
 
+    if (NUI_ADD_EMSCRIPTEN_TARGET_ARGS_EMBED_FILES)
+        set(EMBED_FILES_COMMAND COMMAND $<TARGET_FILE:bin2hpp> ${ENABLE_BIN2HPP} ${CMAKE_BINARY_DIR}/module_${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}/bin ${CMAKE_BINARY_DIR}/include/index_files.hpp index_files)
+    else()
+        set(EMBED_FILES_COMMAND "")
+    endif()
+
     ExternalProject_Add(
         "${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}-emscripten"
         SOURCE_DIR "${SOURCE_DIR}"
@@ -99,6 +108,8 @@ function(nui_add_emscripten_target)
         COMMAND cmake --build "${CMAKE_BINARY_DIR}/module_${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}" --target ${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET} ${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}-parcel
         # convert result to header file containing the page
         COMMAND $<TARGET_FILE:bin2hpp> ${ENABLE_BIN2HPP} ${CMAKE_BINARY_DIR}/module_${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}/bin/index.html ${CMAKE_BINARY_DIR}/include/index.hpp index
+        # or the whole frontend build into a virtual filesystem
+        ${EMBED_FILES_COMMAND}
         BINARY_DIR "${CMAKE_BINARY_DIR}/module_${NUI_ADD_EMSCRIPTEN_TARGET_ARGS_TARGET}"
         BUILD_ALWAYS 1
         INSTALL_COMMAND ""
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string_view>
+
+namespace Nui
+{
+    /**
+     * @brief A file that is compiled into the binary, bin2hpp generates these from a directory.
+     */
+    struct EmbeddedFile
+    {
+        /// Path relative to the embedded directory with a leading slash, like "/index.html".
+        std::string_view path;
+        std::string_view content;
+    };
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace Nui
+{
+    /**
+     * @brief Configures the http cache that is used by Nui::fetch in the backend.
+     */
+    struct FetchCacheOptions
+    {
+        /// Bytes of responses that are kept in memory, least recently used ones are evicted first.
+        std::size_t memoryBudget = 32 * 1024 * 1024;
+
+        /// When set, responses are also stored in this directory and survive restarts of the application.
+        std::optional<std::filesystem::path> diskDirectory = std::nullopt;
+
+        /// Bytes of responses that are kept in the disk directory.
+        std::uintmax_t diskBudget = 256 * 1024 * 1024;
+    };
+}
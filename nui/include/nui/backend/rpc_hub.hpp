@@ -1,12 +1,20 @@
 #pragma once
 
 #include <nui/window.hpp>
+#include <nui/backend/fetch_cache_options.hpp>
 #include <nui/data_structures/selectables_registry.hpp>
 #include <nui/utility/meta/function_traits.hpp>
 #include <nui/utility/meta/pick_first.hpp>
 #include <nlohmann/json.hpp>
 #include <fmt/format.h>
+#include <boost/asio/post.hpp>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <exception>
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -15,6 +23,7 @@
 #include <functional>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 
 namespace Nui
 {
@@ -72,13 +81,76 @@ namespace Nui
                   FunctionReturnType_t<std::decay_t<FunctionT>>,
                   FunctionArgumentTypes_t<std::decay_t<FunctionT>>>
         {};
+
+        template <typename ReturnType, typename ArgsTypes, typename IndexSeq>
+        struct RequestHandlerWrapperImpl
+        {};
+
+        // The first argument of a request is the request id, the arguments of the handler follow.
+        template <typename ReturnType, typename... ArgsTypes, std::size_t... Is>
+        struct RequestHandlerWrapperImpl<ReturnType, std::tuple<ArgsTypes...>, std::index_sequence<Is...>>
+        {
+            template <typename FunctionT>
+            static auto wrapFunction(FunctionT&& func)
+            {
+                return [func = std::move(func)](nlohmann::json const& args) -> ReturnType {
+                    return func(extractJsonMember<ArgsTypes>(args[Is + 1])...);
+                };
+            }
+        };
+
+        template <typename FunctionT>
+        struct RequestHandlerWrapper
+            : public RequestHandlerWrapperImpl<
+                  FunctionReturnType_t<std::decay_t<FunctionT>>,
+                  FunctionArgumentTypes_t<std::decay_t<FunctionT>>,
+                  std::make_index_sequence<std::tuple_size_v<FunctionArgumentTypes_t<std::decay_t<FunctionT>>>>>
+        {};
+
+        template <typename T>
+        struct IsFuture : std::false_type
+        {};
+        template <typename T>
+        struct IsFuture<std::future<T>> : std::true_type
+        {};
+
+        /**
+         * @brief Completes pending futures on a single thread that is started with the first one. The futures are
+         * polled, so none of them blocks the others and they may depend on work that runs on the window executor.
+         * Destroying the waiter stops and joins the thread, completions that did not run by then are dropped.
+         */
+        class FutureWaiter
+        {
+          public:
+            FutureWaiter();
+            ~FutureWaiter();
+            FutureWaiter(FutureWaiter const&) = delete;
+            FutureWaiter& operator=(FutureWaiter const&) = delete;
+            FutureWaiter(FutureWaiter&&) = delete;
+            FutureWaiter& operator=(FutureWaiter&&) = delete;
+
+            /**
+             * @brief Calls poll on the waiter thread until it returns true.
+             */
+            void add(std::function<bool()> poll);
+
+          private:
+            void run();
+
+          private:
+            std::mutex guard_;
+            std::condition_variable wake_;
+            std::vector<std::function<bool()>> added_;
+            bool stopped_;
+            std::thread thread_;
+        };
     }
 
     class RpcHub
     {
       public:
         RpcHub(Window& window);
-        ~RpcHub() = default;
+        ~RpcHub();
         RpcHub(const RpcHub&) = delete;
         RpcHub& operator=(const RpcHub&) = delete;
         RpcHub(RpcHub&&) = delete;
@@ -96,12 +168,87 @@ namespace Nui
             }})();
         )";
 
+        /**
+         * @brief Registers a function that the frontend can call.
+         *
+         * @param name The name of the function.
+         * @param func The function, its parameters are converted from the json arguments.
+         * @param policy Where the function runs. Slow functions should use the thread pool or a strand.
+         */
         template <typename T>
-        void registerFunction(std::string const& name, T&& func) const
+        void registerFunction(std::string const& name, T&& func, RpcExecutionPolicy const& policy = {}) const
         {
             using namespace std::string_literals;
             // window is threadsafe
-            window_->bind(name, Detail::FunctionWrapper<T>::wrapFunction(std::forward<T>(func)));
+            window_->bind(name, Detail::FunctionWrapper<T>::wrapFunction(std::forward<T>(func)), policy);
+        }
+
+        /**
+         * @brief Registers a function that answers requests made with RpcClient::getRemoteCallableWithResult. The
+         * returned value is sent back to the frontend. If a std::future is returned, it is waited for on a thread owned
+         * by the hub, so it may depend on work that runs on the window executor. Futures that are still pending when
+         * the hub is destroyed are not answered.
+         * Exceptions are reported to the frontend as errors.
+         *
+         * @param name The name of the function.
+         * @param func The function, may return void, a value convertible to json or a std::future of one.
+         * @param policy Where the function runs.
+         */
+        template <typename T>
+        void registerRequestHandler(std::string const& name, T&& func, RpcExecutionPolicy const& policy = {}) const
+        {
+            using ReturnType = FunctionReturnType_t<std::decay_t<T>>;
+            window_->bind(
+                name,
+                [this, handler = Detail::RequestHandlerWrapper<T>::wrapFunction(std::forward<T>(func))](
+                    nlohmann::json const& args) {
+                    const auto requestId = args[0].get<std::uint32_t>();
+                    try
+                    {
+                        if constexpr (std::is_void_v<ReturnType>)
+                        {
+                            handler(args);
+                            respond(requestId, nullptr);
+                        }
+                        else if constexpr (Detail::IsFuture<ReturnType>::value)
+                        {
+                            auto future = std::make_shared<ReturnType>(handler(args));
+                            auto complete = [this, requestId, future]() {
+                                try
+                                {
+                                    if constexpr (std::is_void_v<decltype(future->get())>)
+                                    {
+                                        future->get();
+                                        respond(requestId, nullptr);
+                                    }
+                                    else
+                                        respond(requestId, future->get());
+                                }
+                                catch (std::exception const& exc)
+                                {
+                                    respondWithError(requestId, exc.what());
+                                }
+                            };
+                            // Waiting on a pool thread would deadlock once the future depends on the pool itself.
+                            if (future->wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+                                complete();
+                            else
+                                futureWaiter_->add([future, complete = std::move(complete)]() {
+                                    if (future->wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+                                        return false;
+                                    complete();
+                                    return true;
+                                });
+                        }
+                        else
+                            respond(requestId, handler(args));
+                    }
+                    catch (std::exception const& exc)
+                    {
+                        respondWithError(requestId, exc.what());
+                    }
+                },
+                policy);
         }
 
         /**
@@ -115,7 +262,8 @@ namespace Nui
         }
 
         /**
-         * @brief For technical reasons these cannot return a value currently.
+         * @brief Calls a frontend function. These cannot return a value, use registerRequestHandler for functions that
+         * the frontend expects a result from.
          *
          * @tparam Args
          * @param name
@@ -165,6 +313,13 @@ namespace Nui
          */
         void enableFetch() const;
 
+        /**
+         * @brief Enables fetch functionality with a http cache for the responses.
+         *
+         * @param cacheOptions Memory and disk budgets of the cache.
+         */
+        void enableFetch(FetchCacheOptions const& cacheOptions) const;
+
         /**
          * @brief Enables the throttle functionality.
          */
@@ -186,10 +341,35 @@ namespace Nui
         void enableEnvironmentVariables();
 
         /**
-         * @brief Enables all functionality.
+         * @brief Enables saving of frontend render profiles (RenderProfiler::saveTrace). Not part of enableAll, it lets
+         * the frontend write files.
+         *
+         * @param directory Traces are written into this directory. The path given by the frontend is used as a plain
+         * file name, names with directory parts are rejected.
+         */
+        void enableRenderProfiler(std::filesystem::path directory) const;
+
+        /**
+         * @brief Enables all functionality that does not let the frontend write arbitrary files.
          */
         void enableAll();
 
+        /**
+         * @brief Sends calls as MessagePack frames over a custom scheme instead of evaluating them as scripts (see
+         * Window::enableBinaryRpcTransport). Not part of enableAll, must be called before the page is loaded.
+         *
+         * @return true if the binary transport is used, false if the platform falls back to eval.
+         */
+        bool enableBinaryTransport() const;
+
+        /**
+         * @brief Merges calls to the frontend into one script evaluation per batch (see Window::enableRpcBatching).
+         * Useful when the backend sends many small updates. Not part of enableAll.
+         *
+         * @param options When batches are dispatched, by default when the main loop is next idle.
+         */
+        void enableBatching(RpcBatchingOptions const& options = {}) const;
+
         template <typename ManagerT>
         void* accessStateStore(std::string const& id)
         {
@@ -213,23 +393,51 @@ namespace Nui
             }
         }
 
+        /**
+         * @brief Answers a request made with RpcClient::getRemoteCallableWithResult. For functions that answer later,
+         * these are registered with registerFunction and take the request id as their first parameter.
+         *
+         * @param requestId The id of the request.
+         * @param value The result that is passed to the frontend continuation.
+         */
+        void respond(std::uint32_t requestId, nlohmann::json value) const
+        {
+            callRemote("Nui::rpcResponse", nlohmann::json{{"id", requestId}, {"value", std::move(value)}});
+        }
+        void respondWithError(std::uint32_t requestId, std::string const& message) const
+        {
+            callRemote("Nui::rpcResponse", nlohmann::json{{"id", requestId}, {"error", message}});
+        }
+
       private:
         void callRemoteImpl(std::string const& name, nlohmann::json const& json) const
         {
             using namespace std::string_literals;
             // window is threadsafe.
-            window_->eval(fmt::format(remoteCallScript, name, json.dump()));
+            if (window_->binaryRpcTransportEnabled())
+                window_->sendBinaryRpcFrame(nlohmann::json::to_msgpack(nlohmann::json::array({name, json})));
+            else if (window_->rpcBatchingEnabled())
+                window_->queueRpcCall(name, json.dump());
+            else
+                window_->eval(fmt::format(remoteCallScript, name, json.dump()));
         }
         void callRemoteImpl(std::string const& name) const
         {
             using namespace std::string_literals;
             // window is threadsafe.
-            window_->eval(fmt::format(remoteCallScript0Args, name));
+            if (window_->binaryRpcTransportEnabled())
+                window_->sendBinaryRpcFrame(nlohmann::json::to_msgpack(nlohmann::json::array({name})));
+            else if (window_->rpcBatchingEnabled())
+                window_->queueRpcCall(name, {});
+            else
+                window_->eval(fmt::format(remoteCallScript0Args, name));
         }
 
       private:
         std::recursive_mutex guard_;
         Window* window_;
         std::unordered_map<std::string, std::unique_ptr<void, std::function<void(void*)>>> stateStores_;
+        // Last, so that no completion runs while the other members are destroyed.
+        std::unique_ptr<Detail::FutureWaiter> futureWaiter_;
     };
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace Nui
+{
+    /**
+     * @brief Unbounded lock-free queue for many producers and one consumer (the intrusive node queue by Dmitry Vyukov).
+     * push may be called from any thread, pop and drain only from one thread at a time.
+     *
+     * pop may miss an element whose push has not returned yet. Producers should therefore wake the consumer up after
+     * pushing, the element is then picked up by the next drain.
+     */
+    template <typename T>
+    class MpscQueue
+    {
+      public:
+        MpscQueue()
+            : stub_{}
+            , back_{&stub_}
+            , front_{&stub_}
+        {}
+        ~MpscQueue()
+        {
+            while (pop())
+            {}
+        }
+        MpscQueue(MpscQueue const&) = delete;
+        MpscQueue& operator=(MpscQueue const&) = delete;
+        MpscQueue(MpscQueue&&) = delete;
+        MpscQueue& operator=(MpscQueue&&) = delete;
+
+        /**
+         * @brief Appends an element. Never blocks, safe to call from any thread.
+         */
+        void push(T value)
+        {
+            pushNode(new Node{std::move(value)});
+        }
+
+        /**
+         * @brief Removes the first element. Only the consumer thread may call this.
+         *
+         * @return std::optional<T> The element or nullopt if the queue is empty or the next push is not complete.
+         */
+        std::optional<T> pop()
+        {
+            Node* front = front_;
+            Node* next = front->next.load(std::memory_order_acquire);
+            if (front == &stub_)
+            {
+                if (next == nullptr)
+                    return std::nullopt;
+                front_ = next;
+                front = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next != nullptr)
+            {
+                front_ = next;
+                return take(front);
+            }
+            if (front != back_.load(std::memory_order_acquire))
+                return std::nullopt;
+
+            // front is the last node, the stub is put behind it so that front can be removed.
+            pushNode(&stub_);
+            next = front->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                return std::nullopt;
+            front_ = next;
+            return take(front);
+        }
+
+        /**
+         * @brief Pops elements and passes them to the function until the queue is empty. Only the consumer thread may
+         * call this.
+         *
+         * @return std::size_t The amount of elements that were popped.
+         */
+        template <typename FunctionT>
+        std::size_t drain(FunctionT&& function)
+        {
+            std::size_t count = 0;
+            while (auto value = pop())
+            {
+                function(std::move(*value));
+                ++count;
+            }
+            return count;
+        }
+
+      private:
+        struct Node
+        {
+            Node()
+                : value{}
+                , next{nullptr}
+            {}
+            explicit Node(T&& value)
+                : value{std::move(value)}
+                , next{nullptr}
+            {}
+
+            std::optional<T> value;
+            std::atomic<Node*> next;
+        };
+
+        void pushNode(Node* node)
+        {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            Node* previous = back_.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        static std::optional<T> take(Node* node)
+        {
+            std::optional<T> value = std::move(node->value);
+            delete node;
+            return value;
+        }
+
+      private:
+        Node stub_;
+        std::atomic<Node*> back_;
+        Node* front_;
+    };
+}
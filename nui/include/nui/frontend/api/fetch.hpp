@@ -2,6 +2,7 @@
 
 #include <nui/shared/api/fetch_options.hpp>
 
+#include <cstdint>
 #include <string>
 #include <functional>
 #include <optional>
@@ -11,14 +12,30 @@ namespace Nui
     /**
      * @brief Simplified fetch, that uses curl in the backend to fetch data.
      * This circumvents the need for ASYNCIFY. Downloading big amounts of data with this is not optimal.
+     * Requests run concurrently in the backend.
      *
      * @param uri URI to fetch.
      * @param options Options for the fetch.
      * @param callback Callback that is called when the fetch is done.
+     * @return std::uint32_t An id that can be passed to cancelFetch.
      */
-    void fetch(
+    std::uint32_t fetch(
         std::string const& uri,
         FetchOptions const& options,
         std::function<void(std::optional<FetchResponse> const&)> callback);
-    void fetch(std::string const& uri, std::function<void(std::optional<FetchResponse> const&)> callback);
+    std::uint32_t fetch(std::string const& uri, std::function<void(std::optional<FetchResponse> const&)> callback);
+
+    /**
+     * @brief Aborts a fetch, its callback is not called.
+     *
+     * @param fetchId The id returned by fetch.
+     */
+    void cancelFetch(std::uint32_t fetchId);
+
+    /**
+     * @brief Retrieves the counters of the backend http cache. All are zero when the cache is not enabled.
+     *
+     * @param callback Called with the statistics, or nothing if the request failed.
+     */
+    void fetchCacheStatistics(std::function<void(std::optional<FetchCacheStatistics> const&)> callback);
 }
\ No newline at end of file
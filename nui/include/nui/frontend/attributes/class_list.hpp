@@ -0,0 +1,98 @@
+#pragma once
+
+#include <nui/frontend/attributes/impl/attribute.hpp>
+#include <nui/frontend/attributes/impl/attribute_factory.hpp>
+#include <nui/frontend/dom/childless_element.hpp>
+#include <nui/frontend/event_system/observed_value.hpp>
+#include <nui/frontend/event_system/observed_value_combinator.hpp>
+
+namespace Nui::Attributes
+{
+    /**
+     * @brief Binds a single css class to a condition. Changes go through element.classList.toggle, so only the classes
+     * whose condition changed are touched and no class string is ever built.
+     */
+    class ClassToggleFactory
+    {
+      public:
+        explicit constexpr ClassToggleFactory(char const* name)
+            : name_{name}
+        {}
+
+        constexpr char const* name() const
+        {
+            return name_;
+        }
+
+        Attribute operator=(bool enabled) const
+        {
+            return Attribute{[name = name(), enabled](Dom::ChildlessElement& element) {
+                element.toggleClass(name, enabled);
+            }};
+        }
+        template <typename U>
+        requires(IsObserved<std::decay_t<U>>)
+        Attribute operator=(U& val) const
+        {
+            using ObservedType = std::decay_t<U>;
+            return Attribute{Attribute::ObservedBinding{
+                .name = name(),
+                .observed = &val,
+                .setter =
+                    [](Dom::ChildlessElement& element, char const* name, ObservedBase const& observed) {
+                        element.toggleClass(
+                            name, static_cast<bool>(static_cast<ObservedType const&>(observed).value()));
+                    },
+                .createEvent =
+                    [](std::weak_ptr<Dom::ChildlessElement>&& element, char const* name, ObservedBase const& observed) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            Nui::Detail::CopiableObservedWrap{static_cast<ObservedType const&>(observed)},
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.toggleClass(name, static_cast<bool>(value));
+                            });
+                    },
+            }};
+        }
+        template <typename RendererType, typename... ObservedValues>
+        Attribute
+        operator=(ObservedValueCombinatorWithGenerator<RendererType, ObservedValues...> const& combinator) const
+        {
+            return Attribute{Attribute::CombinatorBinding{
+                .setter =
+                    [name = name(), combinator](Dom::ChildlessElement& element) {
+                        element.toggleClass(name, static_cast<bool>(combinator.value()));
+                    },
+                .createEvent =
+                    [name = name(), combinator](std::weak_ptr<Dom::ChildlessElement>&& element) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            combinator,
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.toggleClass(name, static_cast<bool>(value));
+                            });
+                    },
+                .clearEvent =
+                    [combinator](EventContext::EventIdType const& id) {
+                        combinator.unattachEvent(id);
+                    },
+            }};
+        }
+
+      private:
+        char const* name_;
+    };
+
+    struct classList_
+    {
+        /**
+         * @brief classList["active"] = isActive binds a single class, see ClassToggleFactory.
+         */
+        constexpr ClassToggleFactory operator[](char const* name) const
+        {
+            return ClassToggleFactory{name};
+        }
+    } static constexpr classList;
+}
@@ -2,27 +2,88 @@
 
 #include <nui/frontend/dom/element_fwd.hpp>
 #include <nui/frontend/event_system/event_context.hpp>
+#include <nui/frontend/val.hpp>
 
 #include <functional>
 #include <memory>
 #include <string>
+#include <variant>
 
 namespace Nui
 {
+    class ObservedBase;
+
     class Attribute
     {
+      public:
+        /// A value that is set once and never changes. Applied without any type erased calls.
+        struct StaticValue
+        {
+            char const* name;
+            std::variant<std::string, char const*, bool, int, double> value;
+        };
+
+        /// An attribute bound to a single Observed<T>. Uses plain function pointers instead of std::function.
+        struct ObservedBinding
+        {
+            char const* name;
+            ObservedBase const* observed;
+            void (*setter)(Dom::ChildlessElement& element, char const* name, ObservedBase const& observed);
+            EventContext::EventIdType (*createEvent)(
+                std::weak_ptr<Dom::ChildlessElement>&& element,
+                char const* name,
+                ObservedBase const& observed);
+        };
+
+        /// An attribute driven by an observed value combinator or any other custom logic.
+        struct CombinatorBinding
+        {
+            std::function<void(Dom::ChildlessElement&)> setter;
+            std::function<EventContext::EventIdType(std::weak_ptr<Dom::ChildlessElement>&& element)> createEvent;
+            std::function<void(EventContext::EventIdType const&)> clearEvent;
+        };
+
+        /// A DOM event handler like onclick.
+        struct EventHandler
+        {
+            char const* name;
+            std::function<void(Nui::val)> handler;
+        };
+
+        /// A DOM event handler that is dispatched through globalEventDelegation instead of a per element JS function.
+        struct DelegatedEventHandler
+        {
+            char const* name;
+            std::function<void(Nui::val)> handler;
+        };
+
+        using Representation = std::
+            variant<std::monostate, StaticValue, ObservedBinding, CombinatorBinding, EventHandler, DelegatedEventHandler>;
+
       public:
         Attribute()
-            : setter_{}
-            , createEvent_{}
+            : representation_{}
         {}
         Attribute(
             std::function<void(Dom::ChildlessElement&)> setter,
             std::function<EventContext::EventIdType(std::weak_ptr<Dom::ChildlessElement>&& element)> createEvent = {},
             std::function<void(EventContext::EventIdType const&)> clearEvent = {})
-            : setter_{std::move(setter)}
-            , createEvent_{std::move(createEvent)}
-            , clearEvent_{std::move(clearEvent)}
+            : representation_{CombinatorBinding{std::move(setter), std::move(createEvent), std::move(clearEvent)}}
+        {}
+        Attribute(StaticValue staticValue)
+            : representation_{std::move(staticValue)}
+        {}
+        Attribute(ObservedBinding observedBinding)
+            : representation_{std::move(observedBinding)}
+        {}
+        Attribute(CombinatorBinding combinatorBinding)
+            : representation_{std::move(combinatorBinding)}
+        {}
+        Attribute(EventHandler eventHandler)
+            : representation_{std::move(eventHandler)}
+        {}
+        Attribute(DelegatedEventHandler delegatedEventHandler)
+            : representation_{std::move(delegatedEventHandler)}
         {}
 
         Attribute(Attribute const&) = default;
@@ -32,11 +93,22 @@ namespace Nui
 
         void setOn(Dom::ChildlessElement& element) const;
         EventContext::EventIdType createEvent(std::weak_ptr<Dom::ChildlessElement>&& element) const;
+
+        /**
+         * @brief Detaches the event created by createEvent. Does nothing for attributes that dont create events.
+         */
+        void clearEvent(EventContext::EventIdType const& id) const;
         std::function<void(EventContext::EventIdType const&)> getEventClear() const;
 
+        /// Returns true if this attribute creates events and therefore needs clearEvent to be called.
+        bool isDynamic() const;
+
+        Representation const& representation() const
+        {
+            return representation_;
+        }
+
       private:
-        std::function<void(Dom::ChildlessElement&)> setter_;
-        std::function<EventContext::EventIdType(std::weak_ptr<Dom::ChildlessElement>&& element)> createEvent_;
-        std::function<void(EventContext::EventIdType const&)> clearEvent_;
+        Representation representation_;
     };
 }
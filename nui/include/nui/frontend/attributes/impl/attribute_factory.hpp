@@ -13,14 +13,15 @@ namespace Nui::Attributes
 {
     namespace Detail
     {
-        template <typename ElementT, typename T>
-        EventContext::EventIdType defaultSetEvent(std::weak_ptr<ElementT> element, T const& obs, char const* name)
+        template <typename ElementT, typename T, typename SetterT>
+        EventContext::EventIdType
+        defaultSetEvent(std::weak_ptr<ElementT> element, T const& obs, char const* name, SetterT setter)
         {
             const auto eventId = globalEventContext.registerEvent(Event{
-                [element, obs, name](auto eventId) {
+                [element, obs, name, setter](auto eventId) {
                     if (auto shared = element.lock(); shared)
                     {
-                        shared->setAttribute(name, obs.value());
+                        setter(*shared, name, obs.value());
                         return true;
                     }
                     obs.unattachEvent(eventId);
@@ -32,6 +33,22 @@ namespace Nui::Attributes
             obs.attachEvent(eventId);
             return eventId;
         }
+
+        template <typename ElementT, typename T>
+        EventContext::EventIdType defaultSetEvent(std::weak_ptr<ElementT> element, T const& obs, char const* name)
+        {
+            return defaultSetEvent(
+                std::move(element),
+                obs,
+                name,
+                [](ElementT& element, char const* name, auto const& value) {
+                    element.setAttribute(name, value);
+                });
+        }
+
+        template <typename T>
+        concept IsStaticAttributeValue = std::same_as<T, std::string> || std::same_as<T, char const*> ||
+            std::same_as<T, bool> || std::same_as<T, int> || std::same_as<T, double>;
     }
 
     class AttributeFactory
@@ -56,58 +73,93 @@ namespace Nui::Attributes
         requires(!IsObserved<std::decay_t<U>> && !std::invocable<U, Nui::val> && !std::invocable<U>)
         Attribute operator=(U val) const
         {
-            return Attribute{[name = name(), val = std::move(val)](Dom::ChildlessElement& element) {
-                element.setAttribute(name, val);
-            }};
+            if constexpr (Detail::IsStaticAttributeValue<U>)
+            {
+                return Attribute{Attribute::StaticValue{.name = name(), .value = std::move(val)}};
+            }
+            else
+            {
+                return Attribute{[name = name(), val = std::move(val)](Dom::ChildlessElement& element) {
+                    element.setAttribute(name, val);
+                }};
+            }
         }
         template <typename U>
         requires(IsObserved<std::decay_t<U>>)
         Attribute operator=(U& val) const
         {
-            return Attribute{
-                [name = name(), &val](Dom::ChildlessElement& element) {
-                    element.setAttribute(name, val.value());
-                },
-                [name = name(), &val](std::weak_ptr<Dom::ChildlessElement>&& element) {
-                    return Detail::defaultSetEvent(std::move(element), Nui::Detail::CopiableObservedWrap{val}, name);
-                },
-                [&val](EventContext::EventIdType const& id) {
-                    val.unattachEvent(id);
-                }};
+            using ObservedType = std::decay_t<U>;
+            return Attribute{Attribute::ObservedBinding{
+                .name = name(),
+                .observed = &val,
+                .setter =
+                    [](Dom::ChildlessElement& element, char const* name, ObservedBase const& observed) {
+                        element.setAttribute(name, static_cast<ObservedType const&>(observed).value());
+                    },
+                .createEvent =
+                    [](std::weak_ptr<Dom::ChildlessElement>&& element, char const* name, ObservedBase const& observed) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            Nui::Detail::CopiableObservedWrap{static_cast<ObservedType const&>(observed)},
+                            name);
+                    },
+            }};
         }
         template <typename RendererType, typename... ObservedValues>
         Attribute
         operator=(ObservedValueCombinatorWithGenerator<RendererType, ObservedValues...> const& combinator) const
         {
-            return Attribute{
-                [name = name(), combinator](Dom::ChildlessElement& element) {
-                    element.setAttribute(name, combinator.value());
-                },
-                [name = name(), combinator](std::weak_ptr<Dom::ChildlessElement>&& element) {
-                    return Detail::defaultSetEvent(std::move(element), combinator, name);
-                },
-                [combinator](EventContext::EventIdType const& id) {
-                    combinator.unattachEvent(id);
-                }};
+            return Attribute{Attribute::CombinatorBinding{
+                .setter =
+                    [name = name(), combinator](Dom::ChildlessElement& element) {
+                        element.setAttribute(name, combinator.value());
+                    },
+                .createEvent =
+                    [name = name(), combinator](std::weak_ptr<Dom::ChildlessElement>&& element) {
+                        return Detail::defaultSetEvent(std::move(element), combinator, name);
+                    },
+                .clearEvent =
+                    [combinator](EventContext::EventIdType const& id) {
+                        combinator.unattachEvent(id);
+                    },
+            }};
         }
 
         Attribute operator=(std::function<void(Nui::val)> func) const
         {
-            return Attribute{[name = name(), func = std::move(func)](Dom::ChildlessElement& element) {
-                element.setAttribute(name, [func](Nui::val val) {
-                    func(val);
-                    globalEventContext.executeActiveEventsImmediately();
-                });
-            }};
+            return Attribute{Attribute::EventHandler{.name = name(), .handler = std::move(func)}};
         }
 
         Attribute operator=(std::function<void()> func) const
         {
-            return Attribute{[name = name(), func = std::move(func)](Dom::ChildlessElement& element) {
-                element.setAttribute(name, [func](Nui::val) {
-                    func();
-                    globalEventContext.executeActiveEventsImmediately();
-                });
+            return Attribute{Attribute::EventHandler{
+                .name = name(),
+                .handler =
+                    [func = std::move(func)](Nui::val) {
+                        func();
+                    },
+            }};
+        }
+
+        /**
+         * @brief Like assigning an event handler, but the handler is dispatched through one listener per event type
+         * on the document (see EventDelegation). Useful for large numbers of elements with the same event. The
+         * handler sees the document as currentTarget, and stopping propagation also hides the event from non
+         * delegated listeners.
+         */
+        Attribute delegate(std::function<void(Nui::val)> func) const
+        {
+            return Attribute{Attribute::DelegatedEventHandler{.name = name(), .handler = std::move(func)}};
+        }
+
+        Attribute delegate(std::function<void()> func) const
+        {
+            return Attribute{Attribute::DelegatedEventHandler{
+                .name = name(),
+                .handler =
+                    [func = std::move(func)](Nui::val) {
+                        func();
+                    },
             }};
         }
 
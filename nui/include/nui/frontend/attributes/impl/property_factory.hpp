@@ -0,0 +1,96 @@
+#pragma once
+
+#include <nui/frontend/attributes/impl/attribute.hpp>
+#include <nui/frontend/attributes/impl/attribute_factory.hpp>
+#include <nui/frontend/dom/childless_element.hpp>
+#include <nui/frontend/event_system/observed_value.hpp>
+#include <nui/frontend/event_system/observed_value_combinator.hpp>
+
+namespace Nui::Attributes
+{
+    /**
+     * @brief Like AttributeFactory, but writes the live DOM property (element.value = ...) instead of the attribute.
+     * Unchanged values are not written again. Meant for value, checked and selected.
+     */
+    class PropertyFactory
+    {
+      public:
+        explicit constexpr PropertyFactory(char const* name)
+            : name_{name}
+        {}
+
+        constexpr char const* name() const
+        {
+            return name_;
+        }
+
+        template <typename U>
+        requires(!IsObserved<std::decay_t<U>> && !std::invocable<U, Nui::val> && !std::invocable<U>)
+        Attribute operator=(U val) const
+        {
+            return Attribute{[name = name(), val = std::move(val)](Dom::ChildlessElement& element) {
+                element.setProperty(name, val);
+            }};
+        }
+        template <typename U>
+        requires(IsObserved<std::decay_t<U>>)
+        Attribute operator=(U& val) const
+        {
+            using ObservedType = std::decay_t<U>;
+            return Attribute{Attribute::ObservedBinding{
+                .name = name(),
+                .observed = &val,
+                .setter =
+                    [](Dom::ChildlessElement& element, char const* name, ObservedBase const& observed) {
+                        element.setProperty(name, static_cast<ObservedType const&>(observed).value());
+                    },
+                .createEvent =
+                    [](std::weak_ptr<Dom::ChildlessElement>&& element, char const* name, ObservedBase const& observed) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            Nui::Detail::CopiableObservedWrap{static_cast<ObservedType const&>(observed)},
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.setProperty(name, value);
+                            });
+                    },
+            }};
+        }
+        template <typename RendererType, typename... ObservedValues>
+        Attribute
+        operator=(ObservedValueCombinatorWithGenerator<RendererType, ObservedValues...> const& combinator) const
+        {
+            return Attribute{Attribute::CombinatorBinding{
+                .setter =
+                    [name = name(), combinator](Dom::ChildlessElement& element) {
+                        element.setProperty(name, combinator.value());
+                    },
+                .createEvent =
+                    [name = name(), combinator](std::weak_ptr<Dom::ChildlessElement>&& element) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            combinator,
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.setProperty(name, value);
+                            });
+                    },
+                .clearEvent =
+                    [combinator](EventContext::EventIdType const& id) {
+                        combinator.unattachEvent(id);
+                    },
+            }};
+        }
+
+      private:
+        char const* name_;
+    };
+
+    inline namespace Literals
+    {
+        static constexpr PropertyFactory operator"" _prop(char const* name, std::size_t)
+        {
+            return PropertyFactory{name};
+        }
+    }
+}
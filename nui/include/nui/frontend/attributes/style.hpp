@@ -264,8 +264,96 @@ namespace Nui::Attributes
         std::function<std::string()> generateStyle_;
     };
 
+    /**
+     * @brief Binds a single css property. Updates go through element.style.setProperty and only touch this property
+     * instead of rewriting the whole style attribute.
+     */
+    class StylePropertyFactory
+    {
+      public:
+        explicit constexpr StylePropertyFactory(char const* name)
+            : name_{name}
+        {}
+
+        constexpr char const* name() const
+        {
+            return name_;
+        }
+
+        Attribute operator=(std::string value) const
+        {
+            return Attribute{[name = name(), value = std::move(value)](Dom::ChildlessElement& element) {
+                element.setStyleProperty(name, value);
+            }};
+        }
+        Attribute operator=(char const* value) const
+        {
+            return operator=(std::string{value});
+        }
+        template <typename U>
+        requires(IsObserved<std::decay_t<U>>)
+        Attribute operator=(U& val) const
+        {
+            using ObservedType = std::decay_t<U>;
+            return Attribute{Attribute::ObservedBinding{
+                .name = name(),
+                .observed = &val,
+                .setter =
+                    [](Dom::ChildlessElement& element, char const* name, ObservedBase const& observed) {
+                        element.setStyleProperty(name, static_cast<ObservedType const&>(observed).value());
+                    },
+                .createEvent =
+                    [](std::weak_ptr<Dom::ChildlessElement>&& element, char const* name, ObservedBase const& observed) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            Nui::Detail::CopiableObservedWrap{static_cast<ObservedType const&>(observed)},
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.setStyleProperty(name, value);
+                            });
+                    },
+            }};
+        }
+        template <typename RendererType, typename... ObservedValues>
+        Attribute
+        operator=(ObservedValueCombinatorWithGenerator<RendererType, ObservedValues...> const& combinator) const
+        {
+            return Attribute{Attribute::CombinatorBinding{
+                .setter =
+                    [name = name(), combinator](Dom::ChildlessElement& element) {
+                        element.setStyleProperty(name, combinator.value());
+                    },
+                .createEvent =
+                    [name = name(), combinator](std::weak_ptr<Dom::ChildlessElement>&& element) {
+                        return Detail::defaultSetEvent(
+                            std::move(element),
+                            combinator,
+                            name,
+                            [](Dom::ChildlessElement& element, char const* name, auto const& value) {
+                                element.setStyleProperty(name, value);
+                            });
+                    },
+                .clearEvent =
+                    [combinator](EventContext::EventIdType const& id) {
+                        combinator.unattachEvent(id);
+                    },
+            }};
+        }
+
+      private:
+        char const* name_;
+    };
+
     struct style_
     {
+        /**
+         * @brief style["width"] = observedWidth binds a single property, see StylePropertyFactory.
+         */
+        constexpr StylePropertyFactory operator[](char const* name) const
+        {
+            return StylePropertyFactory{name};
+        }
+
         template <typename U>
         requires(!IsObserved<std::decay_t<U>>)
         Attribute operator=(U&& val) const
@@ -11,6 +11,7 @@
 #include <nui/frontend/attributes/selected.hpp>
 #include <nui/frontend/attributes/value.hpp>
 #include <nui/frontend/attributes/on_change.hpp>
+#include <nui/frontend/attributes/impl/property_factory.hpp>
 
 #include <vector>
 #include <functional>
@@ -39,6 +40,7 @@ namespace Nui::Components
     {
         using namespace Attributes;
         using namespace Elements;
+        using namespace Attributes::Literals;
 
         auto attributes = std::move(args.selectAttributes);
         if (args.onSelect)
@@ -54,7 +56,7 @@ namespace Nui::Components
             args.model.map([preSelectedIndex = args.preSelectedIndex](auto i, auto const& opt) {
                 return option{
                     value = opt.value,
-                    selected = (i == preSelectedIndex),
+                    "selected"_prop = (i == preSelectedIndex),
                 }(opt.label);
             })
         );
@@ -10,6 +10,7 @@
 #include <nui/frontend/attributes/type.hpp>
 #include <nui/frontend/attributes/value.hpp>
 #include <nui/frontend/attributes/on_input.hpp>
+#include <nui/frontend/attributes/impl/property_factory.hpp>
 
 namespace Nui::Components
 {
@@ -27,13 +28,13 @@ namespace Nui::Components
             using Nui::Elements::input;
             namespace attr = Nui::Attributes;
             using attr::type;
-            using attr::value;
             using attr::onInput;
+            using namespace attr::Literals;
 
             return input{
                 std::move(attributes)...,
                 type = "text",
-                value = model,
+                "value"_prop = model,
                 onInput =
                     [&model](auto const& event) {
                         model = event["target"]["value"].template as<std::string>();
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <nui/frontend/dom/basic_element.hpp>
+#include <nui/frontend/dom/prerendered_node.hpp>
 #include <nui/frontend/elements/impl/html_element.hpp>
 #include <nui/frontend/utility/functions.hpp>
 
+#include <concepts>
+#include <memory>
+#include <string>
+#include <type_traits>
+
 namespace Nui::Dom
 {
     /**
@@ -14,15 +20,38 @@ namespace Nui::Dom
     {
       public:
         ChildlessElement(HtmlElement const& elem)
-            : BasicElement{ChildlessElement::createElement(elem).val()}
+            : BasicElement{PrerenderScope::active() ? Nui::val::undefined() : createElement(elem).val()}
+            , prerendered_{PrerenderScope::active() ? prerenderElement(elem) : nullptr}
         {}
         ChildlessElement(Nui::val val)
             : BasicElement{std::move(val)}
+            , prerendered_{}
+        {}
+        /// An element without a DOM node, see PrerenderScope.
+        explicit ChildlessElement(std::shared_ptr<PrerenderedNode> prerendered)
+            : BasicElement{Nui::val::undefined()}
+            , prerendered_{std::move(prerendered)}
         {}
 
+        /**
+         * @brief The recorded state of this element if it was created in a PrerenderScope, nullptr otherwise.
+         */
+        std::shared_ptr<PrerenderedNode> const& prerendered() const
+        {
+            return prerendered_;
+        }
+
         // TODO: more overloads?
         void setAttribute(std::string_view key, std::string const& value)
         {
+            if (prerendered_)
+            {
+                if (value.empty())
+                    prerendered_->removeAttribute(key);
+                else
+                    prerendered_->setAttribute(key, value);
+                return;
+            }
             // FIXME: performance, keys are turned to std::string
             if (value.empty())
                 element_.call<Nui::val>("removeAttribute", Nui::val{std::string{key}});
@@ -31,10 +60,15 @@ namespace Nui::Dom
         }
         void setAttribute(std::string_view key, std::invocable<Nui::val> auto&& value)
         {
+            // Event handlers are not part of prerendered html.
+            if (prerendered_)
+                return;
             element_.set(Nui::val{std::string{key}}, Nui::bind(value, std::placeholders::_1));
         }
         void setAttribute(std::string_view key, char const* value)
         {
+            if (prerendered_)
+                return setAttribute(key, std::string{value});
             if (value[0] == '\0')
                 element_.call<Nui::val>("removeAttribute", Nui::val{std::string{key}});
             else
@@ -42,19 +76,31 @@ namespace Nui::Dom
         }
         void setAttribute(std::string_view key, bool value)
         {
+            if (prerendered_)
+            {
+                if (value)
+                    prerendered_->setAttribute(key, std::string{});
+                return;
+            }
             if (value)
                 element_.call<Nui::val>("setAttribute", Nui::val{std::string{key}}, Nui::val{""});
         }
         void setAttribute(std::string_view key, int value)
         {
+            if (prerendered_)
+                return prerendered_->setAttribute(key, static_cast<double>(value));
             element_.call<Nui::val>("setAttribute", Nui::val{std::string{key}}, Nui::val{value});
         }
         void setAttribute(std::string_view key, double value)
         {
+            if (prerendered_)
+                return prerendered_->setAttribute(key, value);
             element_.call<Nui::val>("setAttribute", Nui::val{std::string{key}}, Nui::val{value});
         }
         void setAttribute(std::string_view key, Nui::val value)
         {
+            if (prerendered_)
+                return prerenderValue(key, value);
             element_.call<Nui::val>("setAttribute", Nui::val{std::string{key}}, value);
         }
         template <typename T>
@@ -64,10 +110,102 @@ namespace Nui::Dom
                 setAttribute(key, *value);
         }
 
+        /**
+         * @brief Sets a live DOM property like value or checked (element[key] = value) instead of the attribute. Does
+         * nothing when the property already holds the value, which breaks input -> model -> input feedback loops.
+         */
+        void setProperty(std::string_view key, Nui::val const& value)
+        {
+            if (prerendered_)
+                return prerenderValue(key, value);
+            const Nui::val keyVal{std::string{key}};
+            if (element_[keyVal].strictlyEquals(value))
+                return;
+            element_.set(keyVal, value);
+        }
+        template <typename T>
+        void setProperty(std::string_view key, T const& value)
+        {
+            if (prerendered_)
+            {
+                // Properties like value and checked are written as the attributes they reflect.
+                if constexpr (std::same_as<T, bool>)
+                {
+                    if (value)
+                        prerendered_->setAttribute(key, std::string{});
+                    else
+                        prerendered_->removeAttribute(key);
+                }
+                else if constexpr (std::is_arithmetic_v<T>)
+                    prerendered_->setAttribute(key, static_cast<double>(value));
+                else if constexpr (std::is_convertible_v<T const&, std::string>)
+                    prerendered_->setAttribute(key, std::string{value});
+                return;
+            }
+            setProperty(key, Nui::val{value});
+        }
+        template <typename T>
+        void setProperty(std::string_view key, std::optional<T> const& value)
+        {
+            if (value)
+                setProperty(key, *value);
+        }
+
+        /**
+         * @brief Adds or removes a single class through element.classList.toggle.
+         */
+        void toggleClass(std::string_view name, bool enabled)
+        {
+            if (prerendered_)
+                return prerendered_->toggleClass(name, enabled);
+            element_["classList"].call<Nui::val>("toggle", Nui::val{std::string{name}}, Nui::val{enabled});
+        }
+
+        /**
+         * @brief Sets a single css property through element.style.setProperty. Empty values remove the property.
+         */
+        void setStyleProperty(std::string_view key, std::string const& value)
+        {
+            if (prerendered_)
+                return prerendered_->setStyleProperty(key, value);
+            if (value.empty())
+                element_["style"].call<Nui::val>("removeProperty", Nui::val{std::string{key}});
+            else
+                element_["style"].call<Nui::val>("setProperty", Nui::val{std::string{key}}, Nui::val{value});
+        }
+        void setStyleProperty(std::string_view key, char const* value)
+        {
+            setStyleProperty(key, std::string{value});
+        }
+        template <typename T>
+        void setStyleProperty(std::string_view key, std::optional<T> const& value)
+        {
+            if (value)
+                setStyleProperty(key, *value);
+            else
+                setStyleProperty(key, std::string{});
+        }
+
       protected:
         static ChildlessElement createElement(HtmlElement const& element)
         {
             return {Nui::val::global("document").call<Nui::val>("createElement", Nui::val{element.name()})};
         }
+
+      private:
+        static std::shared_ptr<PrerenderedNode> prerenderElement(HtmlElement const& element)
+        {
+            return std::make_shared<PrerenderedNode>(PrerenderedNode{.tagName = element.name()});
+        }
+        void prerenderValue(std::string_view key, Nui::val const& value)
+        {
+            if (value.isString())
+                prerendered_->setAttribute(key, value.as<std::string>());
+            else if (value.isNumber())
+                prerendered_->setAttribute(key, value.as<double>());
+        }
+
+      protected:
+        std::shared_ptr<PrerenderedNode> prerendered_;
     };
 };
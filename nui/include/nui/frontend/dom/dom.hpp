@@ -3,6 +3,7 @@
 #include <nui/core.hpp>
 #include <nui/frontend/elements/impl/html_element.hpp>
 #include <nui/frontend/dom/element.hpp>
+#include <nui/frontend/dom/hydration.hpp>
 
 #include <optional>
 
@@ -25,6 +26,17 @@ namespace Nui::Dom
             root().replaceElement(std::forward<T>(body));
         }
 
+        /**
+         * @brief Like setBody, but adopts markup that is already in the page (for instance from renderToHtml) instead
+         * of recreating it. Parts that do not match are rendered anew.
+         */
+        template <typename T>
+        void hydrateBody(T&& body)
+        {
+            HydrationScope scope;
+            root().replaceElement(std::forward<T>(body));
+        }
+
       private:
         std::shared_ptr<Element> root_;
     };
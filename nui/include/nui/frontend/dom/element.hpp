@@ -2,12 +2,17 @@
 
 #include <nui/frontend/elements/impl/html_element.hpp>
 #include <nui/frontend/event_system/event_context.hpp>
+#include <nui/frontend/event_system/event_delegation.hpp>
 #include <nui/frontend/dom/childless_element.hpp>
+#include <nui/frontend/dom/hydration.hpp>
 #include <nui/utility/tuple_for_each.hpp>
 
 #include <nui/frontend/val.hpp>
 
+#include <algorithm>
+#include <cctype>
 #include <concepts>
+#include <limits>
 #include <string>
 #include <vector>
 #include <memory>
@@ -50,6 +55,7 @@ namespace Nui::Dom
             : ChildlessElement{elem}
             , children_{}
             , unsetup_{}
+            , hydrationCursor_{noHydration}
         {}
 
         Element(Nui::val val)
@@ -57,6 +63,12 @@ namespace Nui::Dom
             , children_{}
             , unsetup_{}
         {}
+        explicit Element(std::shared_ptr<PrerenderedNode> prerendered)
+            : ChildlessElement{std::move(prerendered)}
+            , children_{}
+            , unsetup_{}
+            , hydrationCursor_{noHydration}
+        {}
 
         Element(Element const&) = delete;
         Element(Element&&) = delete;
@@ -66,7 +78,10 @@ namespace Nui::Dom
         ~Element()
         {
             clearChildren();
-            destroy_(element_);
+            if (prerendered_)
+                prerendered_->remove();
+            else
+                destroy_(element_);
         }
 
         template <typename... Attributes>
@@ -100,8 +115,16 @@ namespace Nui::Dom
         }
         auto appendElement(HtmlElement const& element)
         {
+            if (HydrationScope::active())
+            {
+                if (auto claimed = claimChild(element); claimed)
+                    return children_.emplace_back(std::move(claimed));
+            }
             auto elem = makeElement(element);
-            element_.call<Nui::val>("appendChild", elem->element_);
+            if (prerendered_)
+                prerendered_->appendChild(elem->prerendered_);
+            else
+                element_.call<Nui::val>("appendChild", elem->element_);
             return children_.emplace_back(std::move(elem));
         }
         auto slotFor(value_type const& value)
@@ -111,7 +134,13 @@ namespace Nui::Dom
                 unsetup_();
             unsetup_ = {};
 
-            element_.call<Nui::val>("replaceWith", value->val());
+            if (prerendered_)
+            {
+                prerendered_->replaceWith(value->prerendered_);
+                prerendered_ = value->prerendered_;
+            }
+            else
+                element_.call<Nui::val>("replaceWith", value->val());
             element_ = value->val();
             destroy_ = Detail::doNotDestroy;
             return shared_from_base<Element>();
@@ -128,15 +157,23 @@ namespace Nui::Dom
 
         void setTextContent(std::string const& text)
         {
+            if (prerendered_)
+            {
+                prerendered_->setText(text);
+                return;
+            }
+            if (HydrationScope::active() && element_["textContent"].as<std::string>() == text)
+                return;
+            RenderProfiler::countDomOperation();
             element_.set("textContent", text);
         }
         void setTextContent(char const* text)
         {
-            element_.set("textContent", text);
+            setTextContent(std::string{text});
         }
         void setTextContent(std::string_view text)
         {
-            element_.set("textContent", text);
+            setTextContent(std::string{text});
         }
 
         void
@@ -151,29 +188,38 @@ namespace Nui::Dom
             if (where == end())
                 return appendElement(element);
             auto elem = makeElement(element);
-            element_.call<Nui::val>("insertBefore", elem->element_, (*where)->element_);
+            if (prerendered_)
+                prerendered_->insertBefore(elem->prerendered_, (*where)->prerendered_.get());
+            else
+                element_.call<Nui::val>("insertBefore", elem->element_, (*where)->element_);
             return *children_.insert(where, std::move(elem));
         }
 
         /**
          * @brief Relies on weak_from_this and cannot be used from the constructor
+         *
+         * @param adopted True if the node was adopted from existing markup during hydration. Adopted nodes already
+         * carry their static attributes, so only dynamic attributes and events are applied.
          */
-        void setup(HtmlElement const& element)
+        void setup(HtmlElement const& element, bool adopted = false)
         {
-            std::vector<std::function<void()>> eventClearers;
-            eventClearers.reserve(element.attributes().size());
+            std::vector<EventContext::EventIdType> eventIds;
+            eventIds.reserve(element.attributes().size());
+            bool hasDynamicAttributes = false;
             for (auto const& attribute : element.attributes())
             {
-                attribute.setOn(*this);
-                eventClearers.push_back(
-                    [clear = attribute.getEventClear(), id = attribute.createEvent(weak_from_base<Element>())]() {
-                        if (clear)
-                            clear(id);
-                    });
+                if (!adopted || !std::holds_alternative<Attribute::StaticValue>(attribute.representation()))
+                    attribute.setOn(*this);
+                eventIds.push_back(attribute.createEvent(weak_from_base<Element>()));
+                hasDynamicAttributes = hasDynamicAttributes || attribute.isDynamic();
             }
-            unsetup_ = [eventClearers = std::move(eventClearers)]() {
-                for (auto const& clear : eventClearers)
-                    clear();
+            if (!hasDynamicAttributes)
+                return;
+
+            // The attribute list is immutable and shared, so holding on to it is cheap.
+            unsetup_ = [attributes = element.sharedAttributes(), eventIds = std::move(eventIds)]() {
+                for (std::size_t i = 0; i != eventIds.size(); ++i)
+                    (*attributes)[i].clearEvent(eventIds[i]);
             };
         }
 
@@ -185,6 +231,60 @@ namespace Nui::Dom
                 return insert(begin() + static_cast<decltype(children_)::difference_type>(where), element);
         }
 
+        /**
+         * @brief Lets the browser parse the html (a single element) and inserts it at the given position. The
+         * descendants of the new element are not tracked as children.
+         */
+        auto insertHtml(std::size_t where, char const* html)
+        {
+            if (prerendered_)
+            {
+                auto node = std::make_shared<PrerenderedNode>(PrerenderedNode{.html = html});
+                if (where >= children_.size())
+                    prerendered_->appendChild(node);
+                else
+                    prerendered_->insertBefore(node, children_[where]->prerendered_.get());
+                return *children_.insert(
+                    begin() + static_cast<decltype(children_)::difference_type>(std::min(where, children_.size())),
+                    std::make_shared<Element>(std::move(node)));
+            }
+            if (where >= children_.size())
+            {
+                element_.call<void>("insertAdjacentHTML", Nui::val{"beforeend"}, Nui::val{html});
+                return children_.emplace_back(std::make_shared<Element>(element_["lastElementChild"]));
+            }
+            auto& next = children_[where]->element_;
+            next.call<void>("insertAdjacentHTML", Nui::val{"beforebegin"}, Nui::val{html});
+            return *children_.insert(
+                begin() + static_cast<decltype(children_)::difference_type>(where),
+                std::make_shared<Element>(next["previousElementSibling"]));
+        }
+
+        /**
+         * @brief Like replaceElement, but the replacement is parsed from html (a single element) by the browser.
+         */
+        auto replaceWithHtml(char const* html)
+        {
+            clearChildren();
+            if (unsetup_)
+                unsetup_();
+            unsetup_ = {};
+            globalEventDelegation.removeHandlers(*this);
+
+            if (prerendered_)
+            {
+                auto replacement = std::make_shared<PrerenderedNode>(PrerenderedNode{.html = html});
+                prerendered_->replaceWith(replacement);
+                prerendered_ = std::move(replacement);
+                return shared_from_base<Element>();
+            }
+            element_.call<void>("insertAdjacentHTML", Nui::val{"afterend"}, Nui::val{html});
+            auto replacement = element_["nextElementSibling"];
+            element_.call<void>("remove");
+            element_ = std::move(replacement);
+            return shared_from_base<Element>();
+        }
+
         auto& operator[](std::size_t index)
         {
             return children_[index];
@@ -214,6 +314,54 @@ namespace Nui::Dom
             return children_.size();
         }
 
+        /**
+         * @brief Used during hydration. Adopts the next existing DOM child if its tag matches. On a mismatch all
+         * remaining existing children are removed and rendering falls back to creating new elements.
+         *
+         * Only the tag is compared. Static attributes of an adopted node are neither checked nor reconciled, they are
+         * trusted to match the markup that was prerendered from the same tree.
+         *
+         * @return The adopted element (not yet part of the children list) or nullptr.
+         */
+        std::shared_ptr<Element> claimChild(HtmlElement const& element)
+        {
+            if (hydrationCursor_ == noHydration)
+                return nullptr;
+
+            auto domChildren = element_["children"];
+            if (hydrationCursor_ >= static_cast<std::size_t>(domChildren["length"].as<long long>()))
+                return nullptr;
+
+            auto candidate = domChildren[static_cast<int>(hydrationCursor_)];
+            if (!tagNameEquals(candidate, element.name()))
+            {
+                finishHydration();
+                hydrationCursor_ = noHydration;
+                return nullptr;
+            }
+
+            ++hydrationCursor_;
+            auto elem = std::make_shared<Element>(std::move(candidate));
+            elem->setup(element, true);
+            return elem;
+        }
+
+        /**
+         * @brief Removes existing DOM children that were not adopted during hydration.
+         */
+        void finishHydration()
+        {
+            if (hydrationCursor_ == noHydration)
+                return;
+            auto domChildren = element_["children"];
+            for (auto length = domChildren["length"].as<long long>();
+                 static_cast<std::size_t>(length) > hydrationCursor_;
+                 --length)
+            {
+                domChildren[static_cast<int>(length - 1)].call<void>("remove");
+            }
+        }
+
       private:
         void replaceElementImpl(HtmlElement const& element)
         {
@@ -221,18 +369,50 @@ namespace Nui::Dom
             if (unsetup_)
                 unsetup_();
             unsetup_ = {};
+            globalEventDelegation.removeHandlers(*this);
+
+            if (prerendered_)
+            {
+                auto replacement = std::make_shared<PrerenderedNode>(PrerenderedNode{.tagName = element.name()});
+                prerendered_->replaceWith(replacement);
+                prerendered_ = std::move(replacement);
+                setup(element);
+                return;
+            }
+            if (HydrationScope::active() && tagNameEquals(element_, element.name()))
+            {
+                hydrationCursor_ = 0;
+                setup(element, true);
+                return;
+            }
 
             auto replacement = createElement(element).val();
             element_.call<Nui::val>("replaceWith", replacement);
             element_ = std::move(replacement);
+            // A new node has no markup to adopt.
+            hydrationCursor_ = noHydration;
             setup(element);
         }
 
+        static bool tagNameEquals(Nui::val const& node, char const* name)
+        {
+            // The DOM reports upper case tag names for html elements.
+            const auto tagName = node["tagName"].as<std::string>();
+            const std::string_view expected{name};
+            return std::equal(
+                tagName.begin(), tagName.end(), expected.begin(), expected.end(), [](unsigned char lhs, unsigned char rhs) {
+                    return std::tolower(lhs) == std::tolower(rhs);
+                });
+        }
+
       private:
+        static constexpr std::size_t noHydration = std::numeric_limits<std::size_t>::max();
+
         using destroy_fn = void (*)(Nui::val&);
         destroy_fn destroy_ = Detail::destroyByRemove;
         collection_type children_;
         std::function<void()> unsetup_;
+        std::size_t hydrationCursor_ = 0;
     };
 }
 
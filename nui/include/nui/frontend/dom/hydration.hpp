@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Nui::Dom
+{
+    /**
+     * @brief While a HydrationScope is alive, materializers adopt existing DOM nodes with a matching tag instead of
+     * creating new ones. Only events and reactive bindings are attached to adopted nodes.
+     *
+     * Matching is by tag only: static attributes of adopted nodes are not compared, text is only rewritten if it
+     * differs. Nodes that are created because nothing matched get all of their attributes.
+     */
+    class HydrationScope
+    {
+      public:
+        HydrationScope();
+        HydrationScope(HydrationScope const&) = delete;
+        HydrationScope(HydrationScope&&) = delete;
+        HydrationScope& operator=(HydrationScope const&) = delete;
+        HydrationScope& operator=(HydrationScope&&) = delete;
+        ~HydrationScope();
+
+        static bool active();
+
+      private:
+        bool previous_;
+    };
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Nui::Dom
+{
+    /**
+     * @brief While a PrerenderScope is alive, elements do not create DOM nodes. Every element records what it would
+     * look like in a PrerenderedNode instead, events are not attached. Used by renderToHtml.
+     */
+    class PrerenderScope
+    {
+      public:
+        PrerenderScope();
+        PrerenderScope(PrerenderScope const&) = delete;
+        PrerenderScope(PrerenderScope&&) = delete;
+        PrerenderScope& operator=(PrerenderScope const&) = delete;
+        PrerenderScope& operator=(PrerenderScope&&) = delete;
+        ~PrerenderScope();
+
+        static bool active();
+
+      private:
+        bool previous_;
+    };
+
+    /**
+     * @brief The recorded state of an element that was rendered in a PrerenderScope. The nodes form their own tree
+     * that mirrors what the DOM would contain, including fragment children that elements do not track.
+     */
+    struct PrerenderedNode
+    {
+        std::string tagName;
+        /// In the order they were first set.
+        std::vector<std::pair<std::string, std::string>> attributes;
+        /// Set through textContent, comes before the children.
+        std::string text;
+        /// Markup of an element that was inserted as html, for instance by staticHtml. Serialized as is.
+        std::string html;
+        std::vector<std::shared_ptr<PrerenderedNode>> children;
+        PrerenderedNode* parent = nullptr;
+
+        void appendChild(std::shared_ptr<PrerenderedNode> child);
+
+        /**
+         * @brief Inserts the child before next, or appends it if next is not a child of this node.
+         */
+        void insertBefore(std::shared_ptr<PrerenderedNode> child, PrerenderedNode const* next);
+
+        /**
+         * @brief Takes the place of this node in its parent.
+         */
+        void replaceWith(std::shared_ptr<PrerenderedNode> replacement);
+
+        /**
+         * @brief Detaches this node from its parent.
+         */
+        void remove();
+
+        /**
+         * @brief Replaces the children with the given text, like setting textContent does.
+         */
+        void setText(std::string value);
+
+        void setAttribute(std::string_view name, std::string value);
+        /// Numbers are written the way JavaScript would convert them to a string.
+        void setAttribute(std::string_view name, double value);
+        void removeAttribute(std::string_view name);
+        void toggleClass(std::string_view name, bool enabled);
+        /// Empty values remove the property.
+        void setStyleProperty(std::string_view key, std::string_view value);
+
+        std::string const* attribute(std::string_view name) const;
+    };
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <nui/frontend/elements/impl/html_element.hpp>
+#include <nui/frontend/element_renderer.hpp>
+#include <nui/frontend/dom/element.hpp>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <utility>
+
+namespace Nui::Detail
+{
+    /**
+     * @brief Keeps the elements of inactive switch_ branches alive, so that they can be attached again without
+     * rendering them anew. The least recently used inactive branches are destroyed first.
+     */
+    class KeepAliveCache : public std::enable_shared_from_this<KeepAliveCache>
+    {
+      public:
+        using KeyType = std::size_t;
+
+        explicit KeepAliveCache(std::size_t capacity)
+            : capacity_{capacity}
+            , nextKey_{0}
+            , active_{}
+            , inactive_{}
+        {}
+
+        /**
+         * @brief Wraps the renderer of a branch, so that its element is taken from the cache when available.
+         */
+        ElementRenderer wrap(ElementRenderer renderer)
+        {
+            return [cache = shared_from_this(), key = nextKey_++, renderer = std::move(renderer)](
+                       Dom::Element& actualParent, Renderer const& gen) -> std::shared_ptr<Dom::Element> {
+                return cache->mount(key, renderer, actualParent, gen);
+            };
+        }
+
+        /// Number of inactive branches that are currently kept alive.
+        std::size_t inactiveCount() const
+        {
+            return inactive_.size();
+        }
+
+      private:
+        std::shared_ptr<Dom::Element>
+        mount(KeyType key, ElementRenderer const& renderer, Dom::Element& actualParent, Renderer const& gen)
+        {
+            std::shared_ptr<Dom::Element> element;
+            if (active_.second && active_.first == key)
+                element = std::move(active_.second);
+            else
+            {
+                // Take the branch out before parking, so it cannot be evicted by it.
+                for (auto it = inactive_.begin(); it != inactive_.end(); ++it)
+                {
+                    if (it->first == key)
+                    {
+                        element = std::move(it->second);
+                        inactive_.erase(it);
+                        break;
+                    }
+                }
+                park();
+            }
+
+            if (!element)
+            {
+                // Needs to be valid element for replace and fragments:
+                element = Dom::Element::makeElement(HtmlElement{"div"});
+                element->replaceElement(renderer);
+            }
+            active_ = {key, element};
+            return HtmlElement{"keepalive_slot"}()(actualParent, gen)->slotFor(element);
+        }
+
+        /// Detaches the active branch from the page and moves it into the cache.
+        void park()
+        {
+            if (!active_.second)
+                return;
+
+            auto node = active_.second->val();
+            auto parent = node["parentNode"];
+            if (!parent.isNull() && !parent.isUndefined())
+                parent.call<void>("removeChild", node);
+
+            inactive_.push_front(std::move(active_));
+            active_ = {};
+            while (inactive_.size() > capacity_)
+                inactive_.pop_back();
+        }
+
+      private:
+        std::size_t capacity_;
+        KeyType nextKey_;
+        std::pair<KeyType, std::shared_ptr<Dom::Element>> active_;
+        std::list<std::pair<KeyType, std::shared_ptr<Dom::Element>>> inactive_;
+    };
+}
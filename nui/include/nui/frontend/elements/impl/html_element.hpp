@@ -5,7 +5,9 @@
 #include <nui/frontend/event_system/range.hpp>
 #include <nui/frontend/event_system/event_context.hpp>
 #include <nui/frontend/dom/element_fwd.hpp>
+#include <nui/frontend/dom/hydration.hpp>
 #include <nui/frontend/elements/detail/fragment_context.hpp>
+#include <nui/frontend/utility/render_profiler.hpp>
 #include <nui/frontend/attributes/impl/attribute.hpp>
 #include <nui/concepts.hpp>
 #include <nui/utility/scope_exit.hpp>
@@ -51,8 +53,16 @@ namespace Nui
         /// Works together with inplaceMaterialize.
         inline auto fragmentMaterialize(auto& parent, auto const& htmlElement)
         {
+            if (Dom::HydrationScope::active())
+            {
+                if (auto claimed = parent.claimChild(htmlElement); claimed)
+                    return claimed;
+            }
             auto elem = parent.makeElement(htmlElement);
-            parent.val().template call<Nui::val>("appendChild", elem->val());
+            if (parent.prerendered())
+                parent.prerendered()->appendChild(elem->prerendered());
+            else
+                parent.val().template call<Nui::val>("appendChild", elem->val());
             return elem;
         }
         /// Inserts new element at the given position of the given parent.
@@ -87,6 +97,9 @@ namespace Nui
     };
     auto renderElement(Renderer const& gen, auto& element, auto const& htmlElement)
     {
+        RenderProfiler::Scope profilerScope{"renderElement"};
+        if (gen.type != RendererType::Inplace)
+            RenderProfiler::countDomOperation();
         switch (gen.type)
         {
             case RendererType::Append:
@@ -136,23 +149,32 @@ namespace Nui
       public:
         friend class DomElement;
 
-        constexpr HtmlElement(HtmlElement const&) = default;
-        constexpr HtmlElement(HtmlElement&&) = default;
+        using AttributeList = std::vector<Attribute>;
+
+        HtmlElement(HtmlElement const&) = default;
+        HtmlElement(HtmlElement&&) = default;
         virtual ~HtmlElement() = default;
-        constexpr HtmlElement(char const* name, std::vector<Attribute> const& attributes)
+        HtmlElement(char const* name, std::vector<Attribute> const& attributes)
+            : name_{name}
+            , attributes_{std::make_shared<AttributeList const>(attributes)}
+        {}
+        HtmlElement(char const* name, std::vector<Attribute>&& attributes)
             : name_{name}
-            , attributes_{attributes}
+            , attributes_{std::make_shared<AttributeList const>(std::move(attributes))}
         {}
-        constexpr HtmlElement(char const* name, std::vector<Attribute>&& attributes)
+        HtmlElement(char const* name, std::shared_ptr<AttributeList const> attributes)
             : name_{name}
-            , attributes_{std::move(attributes)}
+            , attributes_{attributes ? std::move(attributes) : emptyAttributes()}
         {}
         template <typename... T>
-        constexpr HtmlElement(char const* name, T&&... attributes)
+        HtmlElement(char const* name, T&&... attributes)
             : name_{name}
-            , attributes_{std::forward<T>(attributes)...}
+            , attributes_{makeAttributeList(std::forward<T>(attributes)...)}
         {}
 
+        /**
+         * @brief Attributes are immutable and shared between clones, so this does not copy them.
+         */
         HtmlElement clone() const
         {
             return {name_, attributes_};
@@ -181,6 +203,7 @@ namespace Nui
                                              fragmentContext = Detail::FragmentContext<ElementType>{},
                                              createdSelfWeak = std::weak_ptr<ElementType>(createdSelf),
                                              childrenRefabricator]() mutable {
+                        RenderProfiler::Scope profilerScope{"reactiveRender"};
                         fragmentContext.clear();
 
                         auto parent = createdSelfWeak.lock();
@@ -205,6 +228,7 @@ namespace Nui
                                              ElementRenderer,
                                              createdSelfWeak = std::weak_ptr<ElementType>(createdSelf),
                                              childrenRefabricator]() mutable {
+                        RenderProfiler::Scope profilerScope{"reactiveRender"};
                         auto parent = createdSelfWeak.lock();
                         if (!parent)
                         {
@@ -248,6 +272,7 @@ namespace Nui
                                     ElementRenderer,
                                     createdSelfWeak = std::weak_ptr<ElementType>(createdSelf),
                                     childrenUpdater]() mutable {
+                    RenderProfiler::Scope profilerScope{"rangeRender"};
                     auto parent = createdSelfWeak.lock();
                     if (!parent)
                     {
@@ -479,6 +504,12 @@ namespace Nui
         }
 
         inline std::vector<Attribute> const& attributes() const
+        {
+            return *attributes_;
+        }
+
+        /// The shared attribute list, can be used to construct other elements with the same attributes.
+        inline std::shared_ptr<AttributeList const> const& sharedAttributes() const
         {
             return attributes_;
         }
@@ -488,9 +519,25 @@ namespace Nui
             return name_;
         }
 
+      private:
+        static std::shared_ptr<AttributeList const> const& emptyAttributes()
+        {
+            static const auto empty = std::make_shared<AttributeList const>();
+            return empty;
+        }
+
+        template <typename... T>
+        static std::shared_ptr<AttributeList const> makeAttributeList(T&&... attributes)
+        {
+            if constexpr (sizeof...(T) == 0)
+                return emptyAttributes();
+            else
+                return std::make_shared<AttributeList const>(AttributeList{std::forward<T>(attributes)...});
+        }
+
       private:
         char const* name_;
-        std::vector<Attribute> attributes_;
+        std::shared_ptr<AttributeList const> attributes_;
     };
 }
 
@@ -499,16 +546,16 @@ namespace Nui
     { \
         struct NAME : HtmlElement \
         { \
-            constexpr NAME(NAME const&) = default; \
-            constexpr NAME(NAME&&) = default; \
-            constexpr NAME(std::vector<Attribute> const& attributes) \
+            NAME(NAME const&) = default; \
+            NAME(NAME&&) = default; \
+            NAME(std::vector<Attribute> const& attributes) \
                 : HtmlElement{HTML_ACTUAL, attributes} \
             {} \
-            constexpr NAME(std::vector<Attribute>&& attributes) \
+            NAME(std::vector<Attribute>&& attributes) \
                 : HtmlElement{HTML_ACTUAL, std::move(attributes)} \
             {} \
             template <typename... T> \
-            constexpr NAME(T&&... attributes) \
+            NAME(T&&... attributes) \
                 : HtmlElement{HTML_ACTUAL, std::forward<T>(attributes)...} \
             {} \
         }; \
@@ -17,8 +17,11 @@ namespace Nui
     std::shared_ptr<Dom::Element>
     ChildrenRenderer<HtmlElem>::operator()(Dom::Element& parentElement, Renderer const& gen) const
     {
+        RenderProfiler::Scope profilerScope{"ChildrenRenderer"};
         auto materialized = renderElement(gen, parentElement, htmlElement_);
         materialized->appendElements(children_);
+        if (Dom::HydrationScope::active())
+            materialized->finishHydration();
         return materialized;
     }
 
@@ -31,6 +34,9 @@ namespace Nui
     std::shared_ptr<Dom::Element>
     TrivialRenderer<HtmlElem>::operator()(Dom::Element& parentElement, Renderer const& gen) const
     {
-        return renderElement(gen, parentElement, htmlElement_);
+        auto materialized = renderElement(gen, parentElement, htmlElement_);
+        if (Dom::HydrationScope::active())
+            materialized->finishHydration();
+        return materialized;
     }
 }
\ No newline at end of file
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <nui/frontend/elements/fragment.hpp>
+#include <nui/frontend/elements/detail/keep_alive_cache.hpp>
 #include <nui/frontend/element_renderer.hpp>
 #include <nui/utility/overloaded.hpp>
 #include <nui/frontend/api/console.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <utility>
 
 namespace Nui::Elements
@@ -41,8 +44,25 @@ namespace Nui::Elements
                 return DefaultBaked{std::move(renderer)};
             }
         };
+
+        template <typename T>
+        auto withKeepAlive(std::shared_ptr<Nui::Detail::KeepAliveCache> const& cache, CaseBaked<T> bakedCase)
+        {
+            return CaseBaked<T>{std::move(bakedCase.value), cache->wrap(std::move(bakedCase.renderer))};
+        }
+        inline auto withKeepAlive(std::shared_ptr<Nui::Detail::KeepAliveCache> const& cache, DefaultBaked bakedDefault)
+        {
+            return DefaultBaked{cache->wrap(std::move(bakedDefault.renderer))};
+        }
     }
 
+    struct SwitchOptions
+    {
+        /// Number of inactive branches that are kept alive (detached, but not destroyed), so that switching back to
+        /// them does not render them again. 0 disables keep-alive.
+        std::size_t keepAlive = 0;
+    };
+
     template <typename T>
     inline auto case_(T&& value)
     {
@@ -83,4 +103,21 @@ namespace Nui::Elements
             },
         };
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Like switch_(observed), but with options like keep-alive of inactive branches.
+     *
+     * Kept alive branches keep their subscriptions, so they are up to date when they are attached again.
+     */
+    template <typename T>
+    constexpr auto switch_(Observed<T>& observed, SwitchOptions options)
+    {
+        return [&observed, options](auto&&... bakedCases) {
+            if (options.keepAlive == 0)
+                return switch_(observed)(std::forward<decltype(bakedCases)>(bakedCases)...);
+
+            auto cache = std::make_shared<Nui::Detail::KeepAliveCache>(options.keepAlive);
+            return switch_(observed)(Detail::withKeepAlive(cache, std::forward<decltype(bakedCases)>(bakedCases))...);
+        };
+    }
+}
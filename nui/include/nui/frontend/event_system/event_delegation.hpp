@@ -0,0 +1,92 @@
+#pragma once
+
+#include <nui/frontend/dom/element_fwd.hpp>
+#include <nui/frontend/val.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Nui
+{
+    /**
+     * @brief Dispatches DOM events through a single listener per event type on the document instead of creating a JS
+     * function for every element. Elements get a numeric id property that indexes a flat table of C++ handlers.
+     *
+     * Listeners are installed in the capture phase of the document, so that non bubbling events (like focus) can be
+     * delegated too, they only reach the target element. Delegated handlers therefore differ from assigned ones:
+     * - They run before any non delegated listener of the same event.
+     * - event.currentTarget is the document. Use event.target or the element the handler was set on instead.
+     * - event.stopPropagation() skips the delegated handlers of the ancestors. It also stops the native event, which
+     *   is still at the document, so no non delegated listener sees it, not even one on the target itself.
+     */
+    class EventDelegation
+    {
+      public:
+        using IdType = std::size_t;
+
+        /// Name of the JS property that holds the delegation id on a DOM node.
+        constexpr static char const* idProperty = "__nuiDelegationId";
+
+        EventDelegation() = default;
+        EventDelegation(EventDelegation const&) = delete;
+        EventDelegation(EventDelegation&&) = delete;
+        EventDelegation& operator=(EventDelegation const&) = delete;
+        EventDelegation& operator=(EventDelegation&&) = delete;
+        ~EventDelegation() = default;
+
+        /**
+         * @brief Adds a handler for the given event type (like "click") to the element and installs the root listener
+         * for that type on first use.
+         */
+        void addHandler(Dom::BasicElement& element, std::string eventType, std::function<void(Nui::val)> handler);
+
+        /**
+         * @brief Drops all handlers of the element. Must be called before the element is set up again, otherwise its
+         * handlers would be added a second time.
+         */
+        void removeHandlers(Dom::BasicElement& element);
+
+        /**
+         * @brief Called by the root listeners. Walks from the event target up to the document and calls all matching
+         * handlers until propagation is stopped.
+         */
+        void dispatch(Nui::val event);
+
+        /// Number of elements that currently own handlers.
+        std::size_t elementCount() const
+        {
+            return slots_.size() - freeSlots_.size();
+        }
+
+        /// Forgets all handlers and installed root listeners. Useful when the document is recreated.
+        void reset();
+
+      private:
+        struct Slot
+        {
+            std::weak_ptr<Dom::BasicElement> element;
+            std::vector<std::pair<std::string, std::function<void(Nui::val)>>> handlers;
+        };
+
+        IdType slotFor(Dom::BasicElement& element);
+        /// The slot, if it belongs to the element.
+        std::optional<IdType> slotOf(Dom::BasicElement& element) const;
+        bool isStale(IdType id) const;
+        void release(IdType id);
+        void sweep();
+        void listenTo(std::string const& eventType);
+
+        std::vector<Slot> slots_{};
+        std::vector<IdType> freeSlots_{};
+        std::unordered_set<std::string> listenedTypes_{};
+        std::size_t sweepThreshold_{64};
+    };
+
+    extern thread_local EventDelegation globalEventDelegation;
+}
@@ -4,18 +4,26 @@
 #include <string>
 #include <functional>
 #include <optional>
+#include <memory>
+#include <cstddef>
 #include <cstdint>
 #include <ios>
 
 namespace Nui
 {
+    class AsyncFileChunks;
+    class AsyncFileWriter;
+
     /**
      * @brief Do note that the use of this class is inefficient. Prefer implementing your file logic on the backend and
-     * pass functions with broader scope through to the frontend.
+     * pass functions with broader scope through to the frontend. For big files use chunks() and writer().
      */
     class AsyncFile
     {
       public:
+        /// Chunk size of chunks(), writer() and readAll.
+        constexpr static std::uint32_t defaultChunkSize = 1024 * 1024;
+
         friend void openFile(
             char const* filename,
             std::ios_base::openmode mode,
@@ -31,22 +39,128 @@ namespace Nui
 
       public:
         ~AsyncFile();
+        AsyncFile(AsyncFile const&) = delete;
+        AsyncFile& operator=(AsyncFile const&) = delete;
+        AsyncFile(AsyncFile&& other) noexcept;
+        AsyncFile& operator=(AsyncFile&& other);
 
-        void tellg(std::function<void(int32_t)> cb) const;
-        void tellp(std::function<void(int32_t)> cb) const;
-        void seekg(int32_t pos, std::function<void()> cb, std::ios_base::seekdir dir = std::ios_base::beg);
-        void seekp(int32_t pos, std::function<void()> cb, std::ios_base::seekdir dir = std::ios_base::beg);
+        void tellg(std::function<void(std::int64_t)> cb) const;
+        void tellp(std::function<void(std::int64_t)> cb) const;
+        void seekg(std::int64_t pos, std::function<void()> cb, std::ios_base::seekdir dir = std::ios_base::beg);
+        void seekp(std::int64_t pos, std::function<void()> cb, std::ios_base::seekdir dir = std::ios_base::beg);
 
+        /**
+         * @brief Reads up to size bytes from the current get position. Fewer are passed at the end of the file.
+         */
         void read(int32_t size, std::function<void(std::string&&)> cb);
+
+        /**
+         * @brief Reads the whole file from the start, chunk by chunk.
+         *
+         * @param cb Called with everything that could be read.
+         */
         void readAll(std::function<void(std::string&&)> cb);
+
+        /**
+         * @brief Writes data at the current put position in a single call. It is sent as bytes over the binary rpc
+         * transport and as base64 otherwise.
+         */
         void write(std::string const& data, std::function<void()> cb);
 
+        /**
+         * @brief Reads the file from the current get position in chunks. Each chunk is read by the backend only when
+         * it is requested, so a slow consumer is never flooded with data.
+         *
+         * @param chunkSize The maximum size of a chunk, the backend limits it to 16 MiB.
+         * @return AsyncFileChunks An iterator that must not outlive this file.
+         */
+        AsyncFileChunks chunks(std::uint32_t chunkSize = defaultChunkSize) const;
+
+        /**
+         * @brief Writes to the file from the current put position in chunks. A chunk is sent only after the backend
+         * wrote the previous one, so neither side ever has to hold more than one chunk in flight.
+         *
+         * @param chunkSize The maximum size of a chunk.
+         * @return AsyncFileWriter A writer that must not outlive this file.
+         */
+        AsyncFileWriter writer(std::uint32_t chunkSize = defaultChunkSize) const;
+
       private:
         AsyncFile(int32_t id);
 
       private:
         int32_t fileId_;
     };
+
+    /**
+     * @brief Asynchronous iterator over the chunks of an AsyncFile.
+     */
+    class AsyncFileChunks
+    {
+      public:
+        /**
+         * @brief Requests the next chunk. Several requests may be pending, they are answered in order.
+         *
+         * @param onChunk Called with the chunk, or nothing after the end of the file or if reading failed.
+         */
+        void next(std::function<void(std::optional<std::string>&&)> onChunk);
+
+        /**
+         * @brief Reads all remaining chunks. Each is requested after the previous one was handled.
+         *
+         * @param onChunk Called for every chunk.
+         * @param onEnd Called after the last chunk or when reading failed.
+         */
+        void forEach(std::function<void(std::string&&)> onChunk, std::function<void()> onEnd = {});
+
+        /**
+         * @brief Whether the end of the file was reached.
+         */
+        bool done() const;
+
+      private:
+        friend class AsyncFile;
+        AsyncFileChunks(int32_t fileId, std::uint32_t chunkSize);
+
+      private:
+        int32_t fileId_;
+        std::uint32_t chunkSize_;
+        std::shared_ptr<bool> done_;
+    };
+
+    /**
+     * @brief Asynchronous chunked writer for an AsyncFile. Copies share their queue.
+     */
+    class AsyncFileWriter
+    {
+      public:
+        /**
+         * @brief Queues data behind everything written before. It is sent one chunk at a time.
+         *
+         * @param onWritten Called with true once all of data was written, or with false if writing failed.
+         */
+        void write(std::string data, std::function<void(bool)> onWritten = {});
+
+        /**
+         * @brief The number of queued bytes that were not written yet.
+         */
+        std::size_t pending() const;
+
+        /**
+         * @brief Whether a write failed. Everything queued is dropped then and later writes fail right away.
+         */
+        bool failed() const;
+
+      private:
+        friend class AsyncFile;
+        AsyncFileWriter(int32_t fileId, std::uint32_t chunkSize);
+
+        struct State;
+        static void sendNext(std::shared_ptr<State> const& state);
+
+      private:
+        std::shared_ptr<State> state_;
+    };
     void openFile(
         char const* filename,
         std::ios_base::openmode mode,
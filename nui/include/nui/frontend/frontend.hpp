@@ -8,6 +8,12 @@
 #include <nui/frontend/rpc_client.hpp>
 #include <nui/frontend/val.hpp>
 
+#include <nui/frontend/utility/async_render.hpp>
 #include <nui/frontend/utility/fragment_listener.hpp>
+#include <nui/frontend/utility/lazy.hpp>
+#include <nui/frontend/utility/memo.hpp>
+#include <nui/frontend/utility/prerender.hpp>
+#include <nui/frontend/utility/render_profiler.hpp>
 #include <nui/frontend/utility/stabilize.hpp>
+#include <nui/frontend/utility/static_html.hpp>
 #include <nui/frontend/utility/val_conversion.hpp>
\ No newline at end of file
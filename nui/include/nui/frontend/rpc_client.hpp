@@ -9,6 +9,8 @@
 
 #include <string>
 #include <cstdint>
+#include <functional>
+#include <optional>
 #include <tuple>
 
 namespace Nui
@@ -100,6 +102,8 @@ namespace Nui
                     Console::error("Remote callable with name '"s + name_ + "' is undefined");
                     return Nui::val::undefined();
                 }
+                if (requestId_)
+                    return callable_(convertToVal(*requestId_), convertToVal(args)...);
                 if (backChannel_.empty())
                     return callable_(convertToVal(args)...);
                 else
@@ -113,6 +117,8 @@ namespace Nui
                     Console::error("Remote callable with name '"s + name_ + "' is undefined");
                     return Nui::val::undefined();
                 }
+                if (requestId_)
+                    return callable_(convertToVal(*requestId_), val);
                 if (backChannel_.empty())
                     return callable_(val);
                 else
@@ -122,6 +128,7 @@ namespace Nui
             RemoteCallable(std::string name)
                 : name_{std::move(name)}
                 , backChannel_{}
+                , requestId_{}
                 , callable_{Nui::val::undefined()}
                 , isSet_{false}
             {}
@@ -129,6 +136,23 @@ namespace Nui
             RemoteCallable(std::string name, std::string backChannel)
                 : name_{std::move(name)}
                 , backChannel_{std::move(backChannel)}
+                , requestId_{}
+                , callable_{Nui::val::undefined()}
+                , isSet_{false}
+            {}
+
+            /**
+             * @brief The id of the request, set for callables from getRemoteCallableWithResult.
+             */
+            std::optional<std::uint32_t> requestId() const
+            {
+                return requestId_;
+            }
+
+            RemoteCallable(std::string name, std::uint32_t requestId)
+                : name_{std::move(name)}
+                , backChannel_{}
+                , requestId_{requestId}
                 , callable_{Nui::val::undefined()}
                 , isSet_{false}
             {}
@@ -146,12 +170,15 @@ namespace Nui
 
                 callable_ = Nui::val::global("nui_rpc")["backend"][name_.c_str()];
                 isSet_ = !callable_.isUndefined();
+                if (!isSet_ && requestId_)
+                    cancelRequest(*requestId_);
                 return isSet_;
             }
 
           private:
             std::string name_;
             std::string backChannel_;
+            std::optional<std::uint32_t> requestId_;
             mutable Nui::val callable_;
             mutable bool isSet_;
         };
@@ -176,6 +203,50 @@ namespace Nui
             return RemoteCallable{std::move(name), registerFunctionOnce(std::forward<FunctionT>(func))};
         }
 
+        /**
+         * @brief Get a callable remote function that was registered with RpcHub::registerRequestHandler. The value
+         * returned by the backend is passed to onResult. Unlike getRemoteCallableWithBackChannel, responses are
+         * correlated by a numeric id, so no temporary function is created in the frontend.
+         *
+         * @param name Name of the function.
+         * @param onResult Called with the result, its parameter is converted from the returned value.
+         * @param onError Called with the message if the backend handler threw.
+         */
+        template <typename FunctionT>
+        static auto getRemoteCallableWithResult(
+            std::string name,
+            FunctionT&& onResult,
+            std::function<void(std::string const&)> onError = {})
+        {
+            return RemoteCallable{
+                std::move(name),
+                registerRequest(
+                    [func = Detail::FunctionWrapper<FunctionT>::wrapFunction(std::forward<FunctionT>(onResult))](
+                        Nui::val const& value) mutable {
+                        func(value);
+                    },
+                    std::move(onError))};
+        }
+
+        /**
+         * @brief Registers a continuation for a request. Called by getRemoteCallableWithResult.
+         *
+         * @return std::uint32_t The id that the backend sends back with the response.
+         */
+        static std::uint32_t registerRequest(
+            std::function<void(Nui::val const&)> onResult,
+            std::function<void(std::string const&)> onError);
+
+        /**
+         * @brief Drops the continuation of a request that will not receive a response.
+         */
+        static void cancelRequest(std::uint32_t requestId);
+
+        /**
+         * @brief Number of requests that wait for a response.
+         */
+        static std::size_t pendingRequestCount();
+
         /**
          * @brief Registers a single shot function that is removed after it was called.
          *
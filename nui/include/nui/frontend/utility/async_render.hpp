@@ -0,0 +1,149 @@
+#pragma once
+
+#include <nui/frontend/elements/impl/html_element.hpp>
+#include <nui/frontend/element_renderer.hpp>
+#include <nui/frontend/dom/element.hpp>
+#include <nui/frontend/api/console.hpp>
+#include <nui/frontend/rpc_client.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace Nui
+{
+    /**
+     * @brief The callbacks of a started AsyncSource. At most one of them is called.
+     */
+    template <typename T>
+    struct AsyncHandlers
+    {
+        std::function<void(T const&)> resolve;
+        /// Called with a message if the operation failed.
+        std::function<void(std::string const&)> reject;
+    };
+
+    /**
+     * @brief Starts an asynchronous operation and calls one of the handlers once it is done. Returns a function that
+     * cancels the operation, it may be empty if the operation cannot be cancelled. Neither handler is called after
+     * the operation was cancelled.
+     */
+    template <typename T>
+    using AsyncSource = std::function<std::function<void()>(AsyncHandlers<T> handlers)>;
+
+    /**
+     * @brief Creates an AsyncSource that calls a backend function registered with RpcHub::registerRequestHandler.
+     * The response is correlated by its request id, an exception in the handler rejects the source and cancelling it
+     * drops the continuation of the request.
+     *
+     * @param name Name of the backend function.
+     * @param args Arguments for the backend function. They are copied and sent when the source is started.
+     */
+    template <typename T, typename... Args>
+    AsyncSource<T> rpcSource(std::string name, Args... args)
+    {
+        return [name = std::move(name), ... args = std::move(args)](AsyncHandlers<T> handlers) -> std::function<void()> {
+            auto callable = RpcClient::getRemoteCallableWithResult(
+                name,
+                [resolve = std::move(handlers.resolve)](T const& value) {
+                    resolve(value);
+                },
+                std::move(handlers.reject));
+            callable(args...);
+            return [requestId = callable.requestId()]() {
+                if (requestId)
+                    RpcClient::cancelRequest(*requestId);
+            };
+        };
+    }
+
+    namespace Detail
+    {
+        /**
+         * @brief Queues a placeholder replacement. All replacements that are queued before the next animation frame
+         * are committed together, followed by a single event execution. Without requestAnimationFrame the
+         * replacement is committed right away.
+         */
+        void commitAsyncRender(std::function<void()> commit);
+
+        /**
+         * @brief An operation that was started for a placeholder and has not finished yet.
+         */
+        struct AsyncOperation
+        {
+            std::weak_ptr<Dom::Element> placeholder;
+            std::function<void()> cancel;
+            bool settled = false;
+        };
+
+        /**
+         * @brief Keeps the operation until it settles. Operations whose placeholder was destroyed before are cancelled
+         * the next time an async render starts or commits.
+         */
+        void trackAsyncOperation(std::shared_ptr<AsyncOperation> operation);
+    }
+
+    /**
+     * @brief Renders the pending element and starts the source. Once the result arrives, the pending element is
+     * replaced with the element returned by ready. Results of multiple outstanding sources are batched into one
+     * re-render. If the placeholder is destroyed before the result arrives, the source is cancelled.
+     *
+     * @param source Started on every render of the returned renderer, for instance from rpcSource.
+     * @param pending Shown until the result arrives. Rendered as an empty div if it renders nothing.
+     * @param ready Creates the actual element from the result.
+     * @param failed Creates the element that replaces the pending one if the source is rejected. Without it, the
+     * message is logged and the pending element stays.
+     * @return ElementRenderer
+     */
+    template <typename T>
+    ElementRenderer asyncRender(
+        AsyncSource<T> source,
+        ElementRenderer pending,
+        std::type_identity_t<std::function<ElementRenderer(T const&)>> ready,
+        std::function<ElementRenderer(std::string const&)> failed = {})
+    {
+        return [source = std::move(source),
+                pending = std::move(pending),
+                ready = std::move(ready),
+                failed = std::move(failed)](
+                   Dom::Element& parentElement, Renderer const& gen) -> std::shared_ptr<Dom::Element> {
+            std::shared_ptr<Dom::Element> placeholder;
+            if (pending)
+                placeholder = pending(parentElement, gen);
+            if (!placeholder)
+                placeholder = renderElement(gen, parentElement, HtmlElement{"div"});
+
+            auto operation = std::make_shared<Detail::AsyncOperation>();
+            operation->placeholder = placeholder;
+            auto replace = [operation](ElementRenderer renderer) {
+                operation->settled = true;
+                Detail::commitAsyncRender([weak = operation->placeholder, renderer = std::move(renderer)]() {
+                    if (auto element = weak.lock(); element)
+                        element->replaceElement(renderer);
+                });
+            };
+
+            operation->cancel = source(AsyncHandlers<T>{
+                .resolve =
+                    [replace, ready](T const& value) {
+                        replace(ready(value));
+                    },
+                .reject =
+                    [operation, replace, failed](std::string const& message) {
+                        using namespace std::string_literals;
+                        if (failed)
+                        {
+                            replace(failed(message));
+                            return;
+                        }
+                        operation->settled = true;
+                        Console::error("Async render failed: "s + message);
+                    },
+            });
+            Detail::trackAsyncOperation(std::move(operation));
+            return placeholder;
+        };
+    }
+}
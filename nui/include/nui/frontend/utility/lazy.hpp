@@ -0,0 +1,36 @@
+#pragma once
+
+#include <nui/frontend/attributes/impl/attribute.hpp>
+#include <nui/frontend/element_renderer.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Nui
+{
+    struct LazyOptions
+    {
+        /// Render when the placeholder scrolls into view (IntersectionObserver).
+        bool whenVisible = true;
+
+        /// Render when the browser is idle, even if the placeholder was never visible (requestIdleCallback).
+        bool whenIdle = true;
+
+        /// Margin around the viewport, so rendering starts slightly before the placeholder becomes visible.
+        std::string rootMargin = "200px";
+
+        /// Attributes of the placeholder div, like a min-height that keeps the scroll position stable.
+        std::vector<Attribute> placeholderAttributes = {};
+    };
+
+    /**
+     * @brief Mounts an empty placeholder and renders the actual subtree in its place once it becomes visible or the
+     * browser is idle. If neither IntersectionObserver nor requestIdleCallback is available the subtree is rendered
+     * right away.
+     *
+     * @param renderer The subtree to render lazily.
+     * @param options See LazyOptions.
+     * @return ElementRenderer
+     */
+    ElementRenderer lazy(ElementRenderer renderer, LazyOptions options = {});
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <nui/frontend/elements/impl/html_element.hpp>
+#include <nui/frontend/element_renderer.hpp>
+#include <nui/frontend/dom/element.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Nui
+{
+    /**
+     * @brief Holds the element and the props of the last render of a memo() call. Must outlive the rendered
+     * element, like StableElement.
+     */
+    template <typename... Props>
+    class Memo
+    {
+      public:
+        Memo()
+            : props_{}
+            , element_{}
+        {}
+
+        /// Forgets the props, so that the next render renders anew even if the props compare equal.
+        void reset()
+        {
+            props_.reset();
+        }
+
+        /// Destroys the memoized element directly, which will make it also disappear from the page.
+        void destroy()
+        {
+            props_.reset();
+            element_.reset();
+        }
+
+        template <typename... MemoProps, typename... Args>
+        friend ElementRenderer memo(Memo<MemoProps...>& memoState, Args&&... args);
+
+      private:
+        std::optional<std::tuple<Props...>> props_;
+        std::shared_ptr<Dom::Element> element_;
+    };
+
+    /**
+     * @brief Like stabilize, but the subtree is only rendered again when the props do not compare equal to the ones
+     * of the previous render. When a reactive parent rebuilds, the existing element is moved into the new slot
+     * instead.
+     *
+     * @code{.cpp}
+     * Memo<std::string> memoState;
+     * // ...
+     * memo(memoState, name, [](std::string const& name) -> ElementRenderer {
+     *     return span{}(name);
+     * });
+     * @endcode
+     *
+     * @param memoState Storage for the element and the props.
+     * @param args The props followed by the renderer. The renderer is either an ElementRenderer or a function that is
+     * called with the props and returns one. Only the latter avoids building the subtree when nothing changed.
+     * @return ElementRenderer
+     */
+    template <typename... Props, typename... Args>
+    ElementRenderer memo(Memo<Props...>& memoState, Args&&... args)
+    {
+        static_assert(
+            sizeof...(Args) == sizeof...(Props) + 1, "memo expects one argument per prop followed by the renderer.");
+
+        auto arguments = std::forward_as_tuple(std::forward<Args>(args)...);
+        return [&]<std::size_t... Indices>(std::index_sequence<Indices...>) -> ElementRenderer {
+            return [&memoState,
+                    props = std::tuple<Props...>{std::get<Indices>(arguments)...},
+                    renderer = std::get<sizeof...(Props)>(arguments)](
+                       Dom::Element& actualParent, Renderer const& gen) -> std::shared_ptr<Dom::Element> {
+                if (!memoState.element_ || !memoState.props_ || !(*memoState.props_ == props))
+                {
+                    memoState.props_ = props;
+                    // Needs to be valid element for replace and fragments:
+                    memoState.element_ = Dom::Element::makeElement(HtmlElement{"div"});
+                    if constexpr (std::is_invocable_r_v<ElementRenderer, decltype(renderer) const&, Props const&...>)
+                        memoState.element_->replaceElement(std::apply(renderer, *memoState.props_));
+                    else
+                        memoState.element_->replaceElement(renderer);
+                }
+                return HtmlElement{"memo_slot"}()(actualParent, gen)->slotFor(memoState.element_);
+            };
+        }(std::make_index_sequence<sizeof...(Props)>{});
+    }
+}
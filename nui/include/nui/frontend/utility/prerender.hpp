@@ -0,0 +1,30 @@
+#pragma once
+
+#include <nui/frontend/element_renderer.hpp>
+#include <nui/frontend/val.hpp>
+
+#include <string>
+
+namespace Nui
+{
+    /**
+     * @brief Renders the tree in a Dom::PrerenderScope and serializes the recorded elements to html. Observed values
+     * are written with their current value, events and reactivity are not part of the output.
+     *
+     * No DOM node is created, so no document is needed. Properties like value and checked are written as the
+     * attributes they reflect. Components that access their DOM node directly through val() are not supported.
+     *
+     * This is part of the frontend and runs wherever the frontend runs, the backend cannot call it. It is meant for
+     * snapshots that are taken at build time, for instance by a small frontend program, and shipped in the page. The
+     * frontend then adopts the snapshot with Dom::hydrateBody instead of rendering it again.
+     *
+     * @param renderer The tree to render.
+     * @return std::string The html of all top level elements.
+     */
+    std::string renderToHtml(ElementRenderer const& renderer);
+
+    /**
+     * @brief Serializes a live DOM element and all its child nodes, including text and comments, to html.
+     */
+    std::string toHtml(Nui::val const& element);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nui
+{
+    /**
+     * @brief Records wall time, DOM operations and allocations of the render entry points, attributed to the
+     * innermost component label (see profile()). Does nothing but check a flag while disabled.
+     *
+     * Allocations are only counted if the frontend library is compiled with NUI_RENDER_PROFILER_COUNT_ALLOCATIONS,
+     * which replaces the global operator new.
+     */
+    class RenderProfiler
+    {
+      public:
+        struct Sample
+        {
+            /// The entry point, like "ChildrenRenderer" or "component" for profile() scopes.
+            char const* name;
+            /// The innermost component label, empty if there is none.
+            std::string component;
+            std::chrono::microseconds start;
+            std::chrono::microseconds duration;
+            /// Includes the operations of nested samples.
+            std::size_t domOperations;
+            /// Includes the allocations of nested samples.
+            std::size_t allocations;
+            std::size_t depth;
+        };
+
+        /// Measures the lifetime of the scope.
+        class Scope
+        {
+          public:
+            explicit Scope(char const* name)
+                : index_{enabled_ ? begin(name, nullptr) : noSample}
+            {}
+            Scope(char const* name, std::string const& component)
+                : index_{enabled_ ? begin(name, &component) : noSample}
+            {}
+            ~Scope()
+            {
+                if (index_ != noSample)
+                    end(index_);
+            }
+            Scope(Scope const&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope const&) = delete;
+            Scope& operator=(Scope&&) = delete;
+
+          private:
+            std::size_t index_;
+        };
+
+        static void enable()
+        {
+            enabled_ = true;
+        }
+        static void disable()
+        {
+            enabled_ = false;
+        }
+        static bool enabled()
+        {
+            return enabled_;
+        }
+
+        static void countDomOperation()
+        {
+            if (enabled_)
+                ++domOperations_;
+        }
+        static void countAllocation()
+        {
+            if (enabled_)
+                ++allocations_;
+        }
+
+        static std::vector<Sample> const& samples();
+        static void clear();
+
+        /**
+         * @brief Exports all samples as Chrome trace event JSON (complete events), which can be loaded in
+         * chrome://tracing or Perfetto.
+         */
+        static std::string toChromeTrace();
+
+        /**
+         * @brief Sends the trace to the backend, which writes it into the directory given to
+         * RpcHub::enableRenderProfiler. Requires that opt-in.
+         *
+         * @param fileName A plain file name, names with directory parts are rejected by the backend.
+         */
+        static void saveTrace(std::string const& fileName);
+
+        /**
+         * @brief Registers "Nui::getRenderProfile" on the frontend. The backend calls it with the name of a backend
+         * function that then receives the trace as a string.
+         */
+        static void exposeOverRpc();
+
+      private:
+        static constexpr std::size_t noSample = static_cast<std::size_t>(-1);
+
+        static std::size_t begin(char const* name, std::string const* component);
+        static void end(std::size_t index);
+
+        static thread_local inline bool enabled_ = false;
+        static thread_local inline std::size_t domOperations_ = 0;
+        static thread_local inline std::size_t allocations_ = 0;
+    };
+
+    /**
+     * @brief Labels everything rendered by the renderer with the component name for the RenderProfiler.
+     */
+    template <typename RendererT>
+    auto profile(std::string component, RendererT renderer)
+    {
+        return [component = std::move(component), renderer = std::move(renderer)](auto& parentElement, auto const& gen) {
+            RenderProfiler::Scope scope{"component", component};
+            return renderer(parentElement, gen);
+        };
+    }
+}
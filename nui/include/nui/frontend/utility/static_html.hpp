@@ -0,0 +1,229 @@
+#pragma once
+
+#include <nui/frontend/element_renderer.hpp>
+#include <nui/utility/fixed_string.hpp>
+
+#include <string>
+#include <type_traits>
+
+namespace Nui
+{
+    /// Compile time html of a single element including all its descendants.
+    template <unsigned Size>
+    struct StaticElement
+    {
+        static constexpr unsigned size = Size;
+        FixedString<Size> html;
+    };
+
+    /// Compile time escaped text node.
+    template <unsigned Size>
+    struct StaticText
+    {
+        static constexpr unsigned size = Size;
+        FixedString<Size> html;
+    };
+
+    /// Compile time attribute, including the leading space: ' name="value"'.
+    template <unsigned Size>
+    struct StaticAttribute
+    {
+        static constexpr unsigned size = Size;
+        FixedString<Size> html;
+    };
+
+    namespace Detail
+    {
+        template <typename T>
+        struct IsStaticAttribute : std::false_type
+        {};
+        template <unsigned Size>
+        struct IsStaticAttribute<StaticAttribute<Size>> : std::true_type
+        {};
+
+        template <typename T>
+        struct IsStaticContent : std::false_type
+        {};
+        template <unsigned Size>
+        struct IsStaticContent<StaticElement<Size>> : std::true_type
+        {};
+        template <unsigned Size>
+        struct IsStaticContent<StaticText<Size>> : std::true_type
+        {};
+
+        constexpr unsigned staticLength(char const* str)
+        {
+            unsigned length = 0;
+            while (str[length] != '\0')
+                ++length;
+            return length;
+        }
+
+        /// Entity for characters that cannot appear as is in text or attribute values, nullptr for all others. Also
+        /// used by renderToHtml.
+        constexpr char const* staticEscape(char c)
+        {
+            switch (c)
+            {
+                case '&':
+                    return "&amp;";
+                case '<':
+                    return "&lt;";
+                case '>':
+                    return "&gt;";
+                case '"':
+                    return "&quot;";
+                default:
+                    return nullptr;
+            }
+        }
+
+        constexpr unsigned staticEscapedLength(char const* str)
+        {
+            unsigned length = 0;
+            for (; *str != '\0'; ++str)
+            {
+                if (auto const* escaped = staticEscape(*str); escaped)
+                    length += staticLength(escaped);
+                else
+                    ++length;
+            }
+            return length;
+        }
+
+        constexpr void staticAppend(char*& dst, char const* src)
+        {
+            for (; *src != '\0'; ++src, ++dst)
+                *dst = *src;
+        }
+
+        constexpr void staticAppendEscaped(char*& dst, char const* src)
+        {
+            for (; *src != '\0'; ++src)
+            {
+                if (auto const* escaped = staticEscape(*src); escaped)
+                    staticAppend(dst, escaped);
+                else
+                    *dst++ = *src;
+            }
+        }
+
+        /// Elements that are serialized without an end tag. Also used by renderToHtml.
+        constexpr bool staticIsVoidElement(char const* name)
+        {
+            constexpr char const* voidElements[] = {
+                "area",
+                "base",
+                "br",
+                "col",
+                "embed",
+                "hr",
+                "img",
+                "input",
+                "link",
+                "meta",
+                "param",
+                "source",
+                "track",
+                "wbr"};
+            for (auto const* voidElement : voidElements)
+            {
+                auto const* lhs = name;
+                auto const* rhs = voidElement;
+                for (; *lhs != '\0' && *lhs == *rhs; ++lhs, ++rhs)
+                    ;
+                if (*lhs == *rhs)
+                    return true;
+            }
+            return false;
+        }
+
+        template <typename T>
+        constexpr void staticAppendIf(char*& dst, T const& part, bool attributes)
+        {
+            if (IsStaticAttribute<T>::value == attributes)
+                staticAppend(dst, part.html);
+        }
+
+        ElementRenderer renderStaticHtml(std::string html);
+    }
+
+    namespace StaticHtml
+    {
+        /**
+         * @brief An attribute for StaticHtml::element. The value is escaped at compile time.
+         */
+        template <FixedString Name, FixedString Value>
+        constexpr auto attribute = []() {
+            constexpr unsigned size = 1 + Name.m_size + 2 + Detail::staticEscapedLength(Value) + 1;
+            StaticAttribute<size> result{};
+            char* dst = result.html.m_buffer;
+            Detail::staticAppend(dst, " ");
+            Detail::staticAppend(dst, Name);
+            Detail::staticAppend(dst, "=\"");
+            Detail::staticAppendEscaped(dst, Value);
+            Detail::staticAppend(dst, "\"");
+            return result;
+        }();
+
+        /**
+         * @brief A text node for StaticHtml::element. The text is escaped at compile time.
+         */
+        template <FixedString Text>
+        constexpr auto text = []() {
+            StaticText<Detail::staticEscapedLength(Text)> result{};
+            char* dst = result.html.m_buffer;
+            Detail::staticAppendEscaped(dst, Text);
+            return result;
+        }();
+
+        /**
+         * @brief Builds the html of a fully static element at compile time. Attributes have to come before children.
+         *
+         * @code{.cpp}
+         * constexpr auto header = StaticHtml::element<"header">(
+         *     StaticHtml::attribute<"class", "header">,
+         *     StaticHtml::element<"h1">(StaticHtml::text<"Title">),
+         *     StaticHtml::element<"hr">()
+         * );
+         * @endcode
+         */
+        template <FixedString Name, typename... Parts>
+        consteval auto element(Parts const&... parts)
+        {
+            static_assert(
+                ((Detail::IsStaticAttribute<Parts>::value || Detail::IsStaticContent<Parts>::value) && ...),
+                "Only StaticHtml::attribute, StaticHtml::text and StaticHtml::element are allowed.");
+
+            constexpr bool isVoid = Detail::staticIsVoidElement(Name);
+            constexpr bool hasChildren = (Detail::IsStaticContent<Parts>::value || ...);
+            static_assert(!isVoid || !hasChildren, "Void elements cannot have children.");
+
+            constexpr unsigned size = 1 + Name.m_size + (0 + ... + Parts::size) + 1 + (isVoid ? 0 : 3 + Name.m_size);
+            StaticElement<size> result{};
+            char* dst = result.html.m_buffer;
+            Detail::staticAppend(dst, "<");
+            Detail::staticAppend(dst, Name);
+            (Detail::staticAppendIf(dst, parts, true), ...);
+            Detail::staticAppend(dst, ">");
+            if constexpr (!isVoid)
+            {
+                (Detail::staticAppendIf(dst, parts, false), ...);
+                Detail::staticAppend(dst, "</");
+                Detail::staticAppend(dst, Name);
+                Detail::staticAppend(dst, ">");
+            }
+            return result;
+        }
+    }
+
+    /**
+     * @brief Renders a tree built with StaticHtml::element. The html is inserted by the browser with a single
+     * insertAdjacentHTML call, no element is created or set up one by one. Only the root element is known to nui.
+     */
+    template <unsigned Size>
+    ElementRenderer staticHtml(StaticElement<Size> const& element)
+    {
+        return Detail::renderStaticHtml(std::string{element.html.m_buffer, Size});
+    }
+}
@@ -26,6 +26,12 @@ namespace Nui
         bool dontDecodeBody = false;
         bool verifyPeer = true;
         bool verifyHost = true;
+        // How the backend http cache is used, same values as the cache option of the browser fetch: "default",
+        // "no-store", "reload", "no-cache", "force-cache" or "only-if-cached". Only has an effect when the cache is
+        // enabled (RpcHub::enableFetch with FetchCacheOptions).
+        std::string cache = "default";
+        // setting this to false keeps the response out of the disk store of the cache, it is still cached in memory.
+        bool cacheOnDisk = true;
     };
     BOOST_DESCRIBE_STRUCT(
         FetchOptions,
@@ -39,7 +45,9 @@ namespace Nui
          autoReferer,
          dontDecodeBody,
          verifyPeer,
-         verifyHost));
+         verifyHost,
+         cache,
+         cacheOnDisk));
 
     struct FetchResponse
     {
@@ -52,4 +60,25 @@ namespace Nui
         std::unordered_map<std::string, std::string> headers;
     };
     BOOST_DESCRIBE_STRUCT(FetchResponse, (), (curlCode, status, proxyStatus, downloadSize, redirectUrl, body, headers));
+
+    struct FetchCacheStatistics
+    {
+        // answered from the cache without a request.
+        uint32_t hits;
+        // answered from the cache after the server confirmed that it is still valid (304).
+        uint32_t revalidations;
+        // cacheable requests that had to download the response.
+        uint32_t misses;
+        // removed from memory to stay within the budget.
+        uint32_t evictions;
+        uint32_t memoryEntries;
+        // sizes are doubles, because 64 bit integers cannot be converted to javascript values.
+        double memoryBytes;
+        uint32_t diskEntries;
+        double diskBytes;
+    };
+    BOOST_DESCRIBE_STRUCT(
+        FetchCacheStatistics,
+        (),
+        (hits, revalidations, misses, evictions, memoryEntries, memoryBytes, diskEntries, diskBytes));
 }
\ No newline at end of file
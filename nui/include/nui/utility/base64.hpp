@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Nui
+{
+    /**
+     * @brief Encodes bytes as base64 with padding, so that they can travel inside json strings.
+     */
+    inline std::string base64Encode(std::string_view data)
+    {
+        constexpr char const* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string encoded;
+        encoded.reserve((data.size() + 2) / 3 * 4);
+        std::size_t i = 0;
+        for (; i + 2 < data.size(); i += 3)
+        {
+            const auto triple = static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << 16 |
+                static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 1])) << 8 |
+                static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 2]));
+            encoded.push_back(alphabet[(triple >> 18) & 0x3f]);
+            encoded.push_back(alphabet[(triple >> 12) & 0x3f]);
+            encoded.push_back(alphabet[(triple >> 6) & 0x3f]);
+            encoded.push_back(alphabet[triple & 0x3f]);
+        }
+        if (i < data.size())
+        {
+            auto triple = static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << 16;
+            if (i + 1 < data.size())
+                triple |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i + 1])) << 8;
+            encoded.push_back(alphabet[(triple >> 18) & 0x3f]);
+            encoded.push_back(alphabet[(triple >> 12) & 0x3f]);
+            encoded.push_back(i + 1 < data.size() ? alphabet[(triple >> 6) & 0x3f] : '=');
+            encoded.push_back('=');
+        }
+        return encoded;
+    }
+
+    /**
+     * @brief Decodes base64, padding is optional.
+     *
+     * @return std::optional<std::string> The bytes, or nothing if the input is not valid base64.
+     */
+    inline std::optional<std::string> base64Decode(std::string_view encoded)
+    {
+        constexpr auto lookup = []() {
+            std::array<std::int8_t, 256> table{};
+            table.fill(-1);
+            constexpr std::string_view alphabet =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (std::size_t i = 0; i < alphabet.size(); ++i)
+                table[static_cast<unsigned char>(alphabet[i])] = static_cast<std::int8_t>(i);
+            return table;
+        }();
+
+        while (!encoded.empty() && encoded.back() == '=')
+            encoded.remove_suffix(1);
+        if (encoded.size() % 4 == 1)
+            return std::nullopt;
+
+        std::string decoded;
+        decoded.reserve(encoded.size() / 4 * 3 + 2);
+        std::uint32_t buffer = 0;
+        int bits = 0;
+        for (const auto c : encoded)
+        {
+            const auto value = lookup[static_cast<unsigned char>(c)];
+            if (value < 0)
+                return std::nullopt;
+            buffer = (buffer << 6) | static_cast<std::uint32_t>(value);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                decoded.push_back(static_cast<char>((buffer >> bits) & 0xff));
+            }
+        }
+        return decoded;
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <nui/core.hpp>
 #ifdef NUI_BACKEND
+#    include <nui/backend/embedded_file.hpp>
 #    include <nlohmann/json.hpp>
 #    include <boost/asio/any_io_executor.hpp>
 #endif
@@ -10,6 +11,11 @@
 #include <string>
 #include <functional>
 #include <filesystem>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <array>
+#include <chrono>
 
 namespace Nui
 {
@@ -29,6 +35,60 @@ namespace Nui
         DenyCors
     };
 
+    /**
+     * @brief Controls when batched calls to the frontend are dispatched, see Window::enableRpcBatching.
+     */
+    struct RpcBatchingOptions
+    {
+        /// Calls are collected for this long. Zero dispatches them when the main loop is next idle.
+        std::chrono::milliseconds window{0};
+        /// A batch is dispatched early when it reaches this many calls. Zero means no limit.
+        std::size_t maxCalls{0};
+    };
+
+    /**
+     * @brief Where a function bound with Window::bind (or RpcHub::registerFunction) runs.
+     */
+    struct RpcExecutionPolicy
+    {
+        enum class Target
+        {
+            /// On the main loop in call order, the function may use the window freely. The default.
+            UiThread,
+            /// On the window thread pool, calls may run concurrently and in any order.
+            ThreadPool,
+            /// On the window thread pool, calls on the same strand run one at a time in call order.
+            Strand
+        };
+
+        Target target{Target::UiThread};
+        /// The name of the strand, only used with Target::Strand.
+        std::string strand{};
+
+        static RpcExecutionPolicy uiThread()
+        {
+            return {};
+        }
+        static RpcExecutionPolicy threadPool()
+        {
+            return {.target = Target::ThreadPool, .strand = {}};
+        }
+        static RpcExecutionPolicy onStrand(std::string name)
+        {
+            return {.target = Target::Strand, .strand = std::move(name)};
+        }
+    };
+
+    struct RpcBatchStatistics
+    {
+        std::uint64_t batches{0};
+        std::uint64_t calls{0};
+        std::size_t lastBatchSize{0};
+        std::size_t largestBatchSize{0};
+        /// Entry i counts the batches with a size in [2^i, 2^(i+1)), the last entry also counts all larger ones.
+        std::array<std::uint64_t, 16> batchSizeHistogram{};
+    };
+
     /**
      * @brief This class encapsulates the webview.
      */
@@ -113,11 +173,16 @@ namespace Nui
 #ifdef NUI_BACKEND
         /**
          * @brief Bind a function into the web context. These will be available under globalThis.nui_rpc.backend.NAME
+         * Calls are parsed on a separate thread and then run where the policy says.
          *
          * @param name The name of the function.
          * @param callback The function to bind.
+         * @param policy Where the callback runs, on the main loop by default.
          */
-        void bind(std::string const& name, std::function<void(nlohmann::json const&)> const& callback);
+        void bind(
+            std::string const& name,
+            std::function<void(nlohmann::json const&)> const& callback,
+            RpcExecutionPolicy const& policy = {});
 
         boost::asio::any_io_executor getExecutor() const;
 
@@ -133,6 +198,20 @@ namespace Nui
             std::filesystem::path const& folderPath,
             HostResourceAccessKind accessKind);
 
+        /**
+         * @brief Map a host name under the assets:// scheme to files that are compiled into the binary, see the
+         * directory mode of bin2hpp. On linux the files are served from where they are, without copying them. On
+         * windows they are written to a temporary folder that is mapped instead.
+         *
+         * @param hostName The host name to map. like "assets://HOSTNAME/...".
+         * @param files The files, they must outlive the window.
+         * @param accessKind [WINDOWS ONLY] The access kind (depends on Cors).
+         */
+        void setVirtualHostNameToEmbeddedFiles(
+            std::string const& hostName,
+            std::span<EmbeddedFile const> files,
+            HostResourceAccessKind accessKind = HostResourceAccessKind::Allow);
+
         /**
          * @brief Run the webview. This function blocks until the window is closed.
          */
@@ -152,6 +231,54 @@ namespace Nui
          */
         void eval(std::string const& js);
 
+        /**
+         * @brief [LINUX ONLY] Moves rpc traffic to length prefixed MessagePack frames over the nui-rpc:// scheme, so
+         * that calls to the frontend are not evaluated as scripts and calls to the backend are not stringified. Must
+         * be called before the page is loaded.
+         *
+         * @return true if the binary transport is used, false if the platform only supports eval.
+         */
+        bool enableBinaryRpcTransport();
+
+        /**
+         * @brief Whether enableBinaryRpcTransport succeeded.
+         */
+        bool binaryRpcTransportEnabled() const;
+
+        /**
+         * @brief Queues a frame for the frontend. Requires the binary rpc transport.
+         *
+         * @param frame A MessagePack encoded [name, args] or [name] array.
+         */
+        void sendBinaryRpcFrame(std::vector<std::uint8_t> const& frame);
+
+        /**
+         * @brief Merges calls to the frontend into one script evaluation per batch instead of one per call. The
+         * frontend runs them in order. The binary rpc transport is not affected, it already sends everything queued
+         * until the next poll at once.
+         *
+         * @param options When batches are dispatched.
+         */
+        void enableRpcBatching(RpcBatchingOptions const& options = {});
+
+        /**
+         * @brief Whether enableRpcBatching was called.
+         */
+        bool rpcBatchingEnabled() const;
+
+        /**
+         * @brief Queues a call of globalThis.nui_rpc.frontend[name]. Requires rpc batching.
+         *
+         * @param name The name of the frontend function.
+         * @param args The JSON encoded argument, empty to pass undefined.
+         */
+        void queueRpcCall(std::string const& name, std::string args);
+
+        /**
+         * @brief Sizes of the batches dispatched so far.
+         */
+        RpcBatchStatistics rpcBatchStatistics() const;
+
         /**
          * @brief Get a pointer to the underlying webview (ICoreWebView2* on windows and WEBKIT_WEB_VIEW on linux.
          *
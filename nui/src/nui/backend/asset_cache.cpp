@@ -0,0 +1,154 @@
+#include "asset_cache.hpp"
+
+#include <roar/mime_type.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <system_error>
+#include <utility>
+
+namespace Nui
+{
+    namespace
+    {
+        std::string_view trim(std::string_view view)
+        {
+            while (!view.empty() && (view.front() == ' ' || view.front() == '\t'))
+                view.remove_prefix(1);
+            while (!view.empty() && (view.back() == ' ' || view.back() == '\t'))
+                view.remove_suffix(1);
+            return view;
+        }
+
+        std::string mimeTypeOf(std::filesystem::path const& file)
+        {
+            const auto mime = Roar::extensionToMime(file.extension().string());
+            return mime ? *mime : "application/octet-stream";
+        }
+
+        std::optional<std::uint64_t> parseNumber(std::string_view view)
+        {
+            std::uint64_t value = 0;
+            const auto [end, error] = std::from_chars(view.data(), view.data() + view.size(), value);
+            if (error != std::errc{} || end != view.data() + view.size() || view.empty())
+                return std::nullopt;
+            return value;
+        }
+    }
+
+    // #####################################################################################################################
+    std::optional<ByteRange> parseByteRange(std::string_view header, std::uint64_t size)
+    {
+        header = trim(header);
+        if (!header.starts_with("bytes="))
+            return std::nullopt;
+        header = trim(header.substr(6));
+        if (header.find(',') != std::string_view::npos)
+            return std::nullopt;
+
+        const auto dash = header.find('-');
+        if (dash == std::string_view::npos)
+            return std::nullopt;
+        const auto first = trim(header.substr(0, dash));
+        const auto last = trim(header.substr(dash + 1));
+
+        if (first.empty())
+        {
+            // Suffix range, the last n bytes.
+            const auto suffix = parseNumber(last);
+            if (!suffix)
+                return std::nullopt;
+            if (*suffix == 0 || size == 0)
+                return ByteRange{.offset = 0, .length = 0, .satisfiable = false};
+            const auto length = std::min(*suffix, size);
+            return ByteRange{.offset = size - length, .length = length, .satisfiable = true};
+        }
+
+        const auto offset = parseNumber(first);
+        if (!offset)
+            return std::nullopt;
+        std::uint64_t end = size == 0 ? 0 : size - 1;
+        if (!last.empty())
+        {
+            const auto lastByte = parseNumber(last);
+            if (!lastByte || *lastByte < *offset)
+                return std::nullopt;
+            end = std::min(end, *lastByte);
+        }
+        if (*offset >= size)
+            return ByteRange{.offset = 0, .length = 0, .satisfiable = false};
+        return ByteRange{.offset = *offset, .length = end - *offset + 1, .satisfiable = true};
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    Asset embeddedAsset(EmbeddedFile const& file)
+    {
+        GBytes* bytes = g_bytes_new_static(file.content.data(), file.content.size());
+        return Asset{
+            .bytes = std::shared_ptr<GBytes>{bytes, &g_bytes_unref},
+            .mimeType = mimeTypeOf(std::filesystem::path{file.path}),
+        };
+    }
+    // #####################################################################################################################
+    AssetCache::AssetCache(std::size_t budget)
+        : budget_{budget}
+        , bytes_{0}
+        , entries_{}
+        , index_{}
+    {}
+    //---------------------------------------------------------------------------------------------------------------------
+    std::optional<Asset> AssetCache::load(std::filesystem::path const& file)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(file, ec);
+        if (ec)
+            return std::nullopt;
+        const auto lastWriteTime = std::filesystem::last_write_time(file, ec);
+        if (ec)
+            return std::nullopt;
+
+        auto key = file.string();
+        if (auto it = index_.find(key); it != index_.end())
+        {
+            auto entry = it->second;
+            if (entry->size == size && entry->lastWriteTime == lastWriteTime)
+            {
+                entries_.splice(entries_.begin(), entries_, entry);
+                return entry->asset;
+            }
+            bytes_ -= static_cast<std::size_t>(entry->size);
+            entries_.erase(entry);
+            index_.erase(it);
+        }
+
+        GError* error = nullptr;
+        GMappedFile* mapped = g_mapped_file_new(key.c_str(), FALSE, &error);
+        if (!mapped)
+        {
+            if (error)
+                g_error_free(error);
+            return std::nullopt;
+        }
+        // The bytes keep the mapping alive.
+        auto bytes = std::shared_ptr<GBytes>{g_mapped_file_get_bytes(mapped), &g_bytes_unref};
+        g_mapped_file_unref(mapped);
+
+        auto asset = Asset{
+            .bytes = std::move(bytes),
+            .mimeType = mimeTypeOf(file),
+        };
+        if (size > budget_)
+            return asset;
+
+        bytes_ += static_cast<std::size_t>(size);
+        entries_.push_front(Entry{.key = key, .lastWriteTime = lastWriteTime, .size = size, .asset = asset});
+        index_[std::move(key)] = entries_.begin();
+        while (bytes_ > budget_)
+        {
+            bytes_ -= static_cast<std::size_t>(entries_.back().size);
+            index_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+        return asset;
+    }
+    // #####################################################################################################################
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <nui/backend/embedded_file.hpp>
+
+#include <gtk/gtk.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Nui
+{
+    /**
+     * @brief A file of a host name mapping. The bytes are a read only mapping of the file and are handed to webkit
+     * without copying them.
+     */
+    struct Asset
+    {
+        std::shared_ptr<GBytes> bytes;
+        std::string mimeType;
+    };
+
+    struct ByteRange
+    {
+        std::uint64_t offset;
+        std::uint64_t length;
+        /// False if the range lies outside of the asset, it has to be answered with 416.
+        bool satisfiable;
+    };
+
+    /**
+     * @brief Parses the value of a Range header. Only single "bytes=" ranges are supported, anything else yields
+     * nullopt and the whole asset is served.
+     *
+     * @param header The value of the Range header, may be empty.
+     * @param size The size of the asset.
+     */
+    std::optional<ByteRange> parseByteRange(std::string_view header, std::uint64_t size);
+
+    /**
+     * @brief Wraps a file that is compiled into the binary, its content is not copied.
+     */
+    Asset embeddedAsset(EmbeddedFile const& file);
+
+    /**
+     * @brief Keeps recently served assets mapped, so that hot assets are neither read nor looked up again. Changed
+     * files are detected by their size and modification time.
+     *
+     * Files are served as they are. Precompressed siblings are not used, WebKitGTK neither sends Accept-Encoding to
+     * custom schemes nor decodes their responses.
+     *
+     * Assets are read only mappings of the files. Replacing a file (writing a new one and renaming it over the old
+     * one) is safe, the mapping keeps the old content. Truncating a file in place while a mapping of it is still
+     * alive makes reads past the new end fail with SIGBUS, so served folders must not be modified that way.
+     *
+     * Only used on the main loop.
+     */
+    class AssetCache
+    {
+      public:
+        /// Bytes of mapped assets that are kept, larger assets are mapped for every request.
+        constexpr static std::size_t defaultBudget = 64 * 1024 * 1024;
+
+        explicit AssetCache(std::size_t budget = defaultBudget);
+
+        /**
+         * @brief Maps a file, or returns the mapping that is cached for it.
+         *
+         * @param file The requested file.
+         * @return std::optional<Asset> The asset, or nothing if the file cannot be mapped.
+         */
+        std::optional<Asset> load(std::filesystem::path const& file);
+
+      private:
+        struct Entry
+        {
+            std::string key;
+            std::filesystem::file_time_type lastWriteTime;
+            std::uintmax_t size;
+            Asset asset;
+        };
+
+      private:
+        std::size_t budget_;
+        std::size_t bytes_;
+        /// Most recently used first.
+        std::list<Entry> entries_;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    };
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+namespace Nui::Detail
+{
+    /**
+     * @brief Frontend side of the binary rpc transport. Must be called like "(script)(canPost)", canPost is false if
+     * the webview cannot read request bodies, then calls to the backend keep using external.invoke.
+     *
+     * Frames are a big endian uint32 length followed by a MessagePack encoded array. Backend to frontend frames are
+     * [name, args] or [name] and are fetched by a long poll on nui-rpc://rpc/poll. Frontend to backend frames are
+     * [id, args] and are posted in batches to nui-rpc://rpc/call.
+     */
+    constexpr static char const* binaryRpcScript = R"((canPost) => {
+        const rpc = (globalThis.nui_rpc = globalThis.nui_rpc || { frontend: {}, backend: {}, tempId: 0 });
+        if (rpc.binaryTransport)
+            return;
+        rpc.binaryTransport = true;
+
+        const url = "nui-rpc://rpc/";
+        const textEncoder = new TextEncoder();
+        const textDecoder = new TextDecoder();
+
+        class Writer {
+            constructor() {
+                this.buffer = new Uint8Array(1024);
+                this.view = new DataView(this.buffer.buffer);
+                this.length = 0;
+            }
+            reserve(size) {
+                if (this.length + size <= this.buffer.length)
+                    return;
+                const grown = new Uint8Array(Math.max(this.buffer.length * 2, this.length + size));
+                grown.set(this.buffer.subarray(0, this.length));
+                this.buffer = grown;
+                this.view = new DataView(grown.buffer);
+            }
+            uint8(value) {
+                this.reserve(1);
+                this.view.setUint8(this.length, value);
+                this.length += 1;
+            }
+            uint16(value) {
+                this.reserve(2);
+                this.view.setUint16(this.length, value);
+                this.length += 2;
+            }
+            uint32(value) {
+                this.reserve(4);
+                this.view.setUint32(this.length, value);
+                this.length += 4;
+            }
+            int32(value) {
+                this.reserve(4);
+                this.view.setInt32(this.length, value);
+                this.length += 4;
+            }
+            int64(value) {
+                this.reserve(8);
+                this.view.setBigInt64(this.length, BigInt(value));
+                this.length += 8;
+            }
+            float64(value) {
+                this.reserve(8);
+                this.view.setFloat64(this.length, value);
+                this.length += 8;
+            }
+            bytes(array) {
+                this.reserve(array.length);
+                this.buffer.set(array, this.length);
+                this.length += array.length;
+            }
+            header(length, fixType, fixLimit, type8, type16, type32) {
+                if (length < fixLimit)
+                    this.uint8(fixType | length);
+                else if (type8 !== undefined && length < 0x100) {
+                    this.uint8(type8);
+                    this.uint8(length);
+                } else if (length < 0x10000) {
+                    this.uint8(type16);
+                    this.uint16(length);
+                } else {
+                    this.uint8(type32);
+                    this.uint32(length);
+                }
+            }
+        }
+
+        // Mirrors what JSON.stringify would have sent, except that binary data stays binary.
+        const encode = (writer, value) => {
+            if (value === null || value === undefined || typeof value === "function")
+                writer.uint8(0xc0);
+            else if (typeof value === "boolean")
+                writer.uint8(value ? 0xc3 : 0xc2);
+            else if (typeof value === "number") {
+                if (!Number.isSafeInteger(value)) {
+                    writer.uint8(0xcb);
+                    writer.float64(value);
+                } else if (value >= -0x20 && value < 0x80)
+                    writer.uint8(value & 0xff);
+                else if (value >= 0 && value <= 0xffffffff) {
+                    writer.uint8(0xce);
+                    writer.uint32(value);
+                } else if (value >= -0x80000000 && value < 0) {
+                    writer.uint8(0xd2);
+                    writer.int32(value);
+                } else {
+                    writer.uint8(0xd3);
+                    writer.int64(value);
+                }
+            } else if (typeof value === "bigint") {
+                writer.uint8(0xd3);
+                writer.int64(value);
+            } else if (typeof value === "string") {
+                const bytes = textEncoder.encode(value);
+                writer.header(bytes.length, 0xa0, 0x20, 0xd9, 0xda, 0xdb);
+                writer.bytes(bytes);
+            } else if (value instanceof ArrayBuffer || ArrayBuffer.isView(value)) {
+                const bytes = value instanceof ArrayBuffer
+                    ? new Uint8Array(value)
+                    : new Uint8Array(value.buffer, value.byteOffset, value.byteLength);
+                writer.header(bytes.length, 0xc4, 0, 0xc4, 0xc5, 0xc6);
+                writer.bytes(bytes);
+            } else if (Array.isArray(value)) {
+                writer.header(value.length, 0x90, 0x10, undefined, 0xdc, 0xdd);
+                for (const element of value)
+                    encode(writer, element);
+            } else if (typeof value.toJSON === "function")
+                encode(writer, value.toJSON());
+            else {
+                const keys = Object.keys(value).filter(
+                    (key) => value[key] !== undefined && typeof value[key] !== "function");
+                writer.header(keys.length, 0x80, 0x10, undefined, 0xde, 0xdf);
+                for (const key of keys) {
+                    encode(writer, key);
+                    encode(writer, value[key]);
+                }
+            }
+        };
+
+        const decode = (view, state) => {
+            const take = (length) => {
+                const begin = state.offset;
+                state.offset += length;
+                return begin;
+            };
+            const str = (length) => textDecoder.decode(new Uint8Array(view.buffer, take(length), length));
+            const bin = (length) => {
+                const begin = take(length);
+                return new Uint8Array(view.buffer.slice(begin, begin + length));
+            };
+            const array = (length) => {
+                const result = [];
+                for (let i = 0; i < length; ++i)
+                    result.push(decode(view, state));
+                return result;
+            };
+            const map = (length) => {
+                const result = {};
+                for (let i = 0; i < length; ++i) {
+                    const key = decode(view, state);
+                    result[key] = decode(view, state);
+                }
+                return result;
+            };
+
+            const type = view.getUint8(take(1));
+            if (type < 0x80)
+                return type;
+            if (type < 0x90)
+                return map(type & 0x0f);
+            if (type < 0xa0)
+                return array(type & 0x0f);
+            if (type < 0xc0)
+                return str(type & 0x1f);
+            if (type >= 0xe0)
+                return type - 0x100;
+            switch (type) {
+                case 0xc0: return null;
+                case 0xc2: return false;
+                case 0xc3: return true;
+                case 0xc4: return bin(view.getUint8(take(1)));
+                case 0xc5: return bin(view.getUint16(take(2)));
+                case 0xc6: return bin(view.getUint32(take(4)));
+                case 0xca: return view.getFloat32(take(4));
+                case 0xcb: return view.getFloat64(take(8));
+                case 0xcc: return view.getUint8(take(1));
+                case 0xcd: return view.getUint16(take(2));
+                case 0xce: return view.getUint32(take(4));
+                case 0xcf: return Number(view.getBigUint64(take(8)));
+                case 0xd0: return view.getInt8(take(1));
+                case 0xd1: return view.getInt16(take(2));
+                case 0xd2: return view.getInt32(take(4));
+                case 0xd3: return Number(view.getBigInt64(take(8)));
+                case 0xd9: return str(view.getUint8(take(1)));
+                case 0xda: return str(view.getUint16(take(2)));
+                case 0xdb: return str(view.getUint32(take(4)));
+                case 0xdc: return array(view.getUint16(take(2)));
+                case 0xdd: return array(view.getUint32(take(4)));
+                case 0xde: return map(view.getUint16(take(2)));
+                case 0xdf: return map(view.getUint32(take(4)));
+            }
+            throw new Error("nui-rpc: unsupported MessagePack type " + type);
+        };
+
+        const dispatch = (buffer) => {
+            const view = new DataView(buffer);
+            const state = { offset: 0 };
+            while (state.offset + 4 <= view.byteLength) {
+                const end = state.offset + 4 + view.getUint32(state.offset);
+                state.offset += 4;
+                try {
+                    const call = decode(view, state);
+                    rpc.frontend[call[0]](call.length > 1 ? call[1] : undefined);
+                } catch (error) {
+                    console.error("nui-rpc: frontend call failed", error);
+                }
+                state.offset = end;
+            }
+        };
+
+        const poll = () => {
+            fetch(url + "poll")
+                .then((response) => response.arrayBuffer())
+                .then((buffer) => {
+                    dispatch(buffer);
+                    poll();
+                })
+                .catch((error) => {
+                    console.error("nui-rpc: poll failed", error);
+                    setTimeout(poll, 100);
+                });
+        };
+        poll();
+
+        if (!canPost)
+            return;
+
+        // Only one request is in flight, calls made meanwhile are sent together afterwards.
+        const outgoing = new Writer();
+        let sending = false;
+        const flush = () => {
+            if (sending || outgoing.length === 0)
+                return;
+            sending = true;
+            const body = outgoing.buffer.slice(0, outgoing.length);
+            outgoing.length = 0;
+            fetch(url + "call", { method: "POST", body: body })
+                .catch((error) => console.error("nui-rpc: call failed", error))
+                .finally(() => {
+                    sending = false;
+                    flush();
+                });
+        };
+        rpc.sendBinary = (id, args) => {
+            const begin = outgoing.length;
+            outgoing.uint32(0);
+            encode(outgoing, [id, args]);
+            outgoing.view.setUint32(begin, outgoing.length - begin - 4);
+            if (!sending)
+                queueMicrotask(flush);
+        };
+    })";
+}
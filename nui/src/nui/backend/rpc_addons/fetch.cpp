@@ -1,11 +1,17 @@
 #include "fetch.hpp"
+#include "fetch_cache.hpp"
+#include "fetch_client.hpp"
 
 #include <nui/shared/api/fetch_options.hpp>
-#include <roar/curl/request.hpp>
 #include <roar/url/url.hpp>
 #include <roar/utility/base64.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace Nui
 {
@@ -21,7 +27,9 @@ namespace Nui
         autoReferer,
         dontDecodeBody,
         verifyPeer,
-        verifyHost);
+        verifyHost,
+        cache,
+        cacheOnDisk);
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
         FetchResponse,
         curlCode,
@@ -31,15 +39,102 @@ namespace Nui
         redirectUrl,
         body,
         headers)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(
+        FetchCacheStatistics,
+        hits,
+        revalidations,
+        misses,
+        evictions,
+        memoryEntries,
+        memoryBytes,
+        diskEntries,
+        diskBytes)
 
-    void registerFetch(Nui::RpcHub const& hub)
+    namespace
     {
-        hub.registerFunction(
-            "Nui::fetch", [&hub](std::string const& responseId, std::string url, FetchOptions const& options) {
-                std::string body;
-                auto request = Roar::Curl::Request{};
-                std::unordered_map<std::string, std::string> headers;
+        /// Accepts only the well-formed sequences of table 3-7 of the Unicode standard. Overlong forms, surrogates and
+        /// code points above U+10FFFF are rejected, json refuses to serialize them.
+        bool isValidUtf8(std::string_view text)
+        {
+            std::size_t i = 0;
+            while (i < text.size())
+            {
+                const auto lead = static_cast<unsigned char>(text[i]);
+                if (lead < 0x80)
+                {
+                    ++i;
+                    continue;
+                }
+
+                std::size_t length = 0;
+                // Bounds of the second byte, the following ones are plain continuation bytes.
+                unsigned char low = 0x80;
+                unsigned char high = 0xbf;
+                if (lead >= 0xc2 && lead <= 0xdf)
+                    length = 2;
+                else if (lead >= 0xe0 && lead <= 0xef)
+                {
+                    length = 3;
+                    if (lead == 0xe0)
+                        low = 0xa0;
+                    else if (lead == 0xed)
+                        high = 0x9f;
+                }
+                else if (lead >= 0xf0 && lead <= 0xf4)
+                {
+                    length = 4;
+                    if (lead == 0xf0)
+                        low = 0x90;
+                    else if (lead == 0xf4)
+                        high = 0x8f;
+                }
+                else
+                    return false;
+
+                if (i + length > text.size())
+                    return false;
+                const auto second = static_cast<unsigned char>(text[i + 1]);
+                if (second < low || second > high)
+                    return false;
+                for (std::size_t j = 2; j < length; ++j)
+                {
+                    if ((static_cast<unsigned char>(text[i + j]) & 0xc0) != 0x80)
+                        return false;
+                }
+                i += length;
+            }
+            return true;
+        }
+
+        /// Header names and values are raw bytes, if any of them is not valid utf-8 all of them are sent as base64.
+        bool encodeHeadersIfBinary(std::unordered_map<std::string, std::string>& headers)
+        {
+            const bool binary = std::any_of(headers.begin(), headers.end(), [](auto const& header) {
+                return !isValidUtf8(header.first) || !isValidUtf8(header.second);
+            });
+            if (!binary)
+                return false;
+
+            std::unordered_map<std::string, std::string> encoded;
+            encoded.reserve(headers.size());
+            for (auto const& [name, value] : headers)
+                encoded.emplace(Roar::base64Encode(name), Roar::base64Encode(value));
+            headers = std::move(encoded);
+            return true;
+        }
+    }
+
+    void registerFetch(Nui::RpcHub const& hub, std::optional<FetchCacheOptions> const& cacheOptions)
+    {
+        // Requests run concurrently on one curl multi handle and are answered when complete, so these functions
+        // return right away.
+        auto client = std::make_shared<FetchClient>(hub.window().getExecutor());
+        auto cache = cacheOptions ? std::make_shared<FetchCache>(*cacheOptions) : nullptr;
 
+        // Cache lookups may read from the disk, so requests are started on a strand.
+        hub.registerFunction(
+            "Nui::fetch",
+            [&hub, client, cache](std::uint32_t requestId, std::string url, FetchOptions const& options) {
                 bool badUrl = false;
                 const auto parsedUrl = boost::leaf::try_handle_some(
                     [&url]() {
@@ -53,33 +148,91 @@ namespace Nui
                     });
                 if (badUrl)
                 {
-                    hub.callRemote(responseId, nlohmann::json());
+                    hub.respond(requestId, nlohmann::json());
                     return;
                 }
 
-                request.sink(body)
-                    .followRedirects(options.followRedirects)
-                    .maxRedirects(static_cast<std::size_t>(options.maxRedirects))
-                    .verbose(options.verbose)
-                    .setHeaderFields(options.headers)
-                    .autoReferer(options.autoReferer)
-                    .verifyPeer(options.verifyPeer)
-                    .verifyHost(options.verifyHost)
-                    .headerSink(headers);
-                if (!options.body.empty() && options.method != "GET")
-                    request.source(options.body);
-
-                const auto response = request.method("GET").url(parsedUrl.value().toString(true, false)).perform();
-                FetchResponse resp{
-                    .curlCode = response.result(),
-                    .status = static_cast<int>(response.code()),
-                    .proxyStatus = static_cast<int>(response.proxyCode()),
-                    .downloadSize = static_cast<uint32_t>(response.sizeOfDownload()),
-                    .redirectUrl = response.redirectUrl(),
-                    .body = Roar::base64Encode(body),
-                    .headers = std::move(headers)};
-
-                hub.callRemote(responseId, resp);
-            });
+                auto onDone = [&hub, requestId, dontDecodeBody = options.dontDecodeBody](FetchResult&& result) {
+                    try
+                    {
+                        // Text is sent as is. Binary bodies go as MessagePack bin over the binary rpc transport
+                        // and only need base64 to get through json when calls are evaluated as scripts.
+                        const bool binary = !isValidUtf8(result.body);
+                        const bool bytes = binary && !dontDecodeBody && hub.window().binaryRpcTransportEnabled();
+                        const bool base64 = dontDecodeBody || (binary && !bytes);
+                        const bool headersBase64 = encodeHeadersIfBinary(result.headers);
+                        std::string body;
+                        if (base64)
+                            body = Roar::base64Encode(result.body);
+                        else if (!bytes)
+                            body = std::move(result.body);
+                        nlohmann::json response = FetchResponse{
+                            .curlCode = static_cast<int32_t>(result.curlCode),
+                            .status = static_cast<int32_t>(result.status),
+                            .proxyStatus = static_cast<int32_t>(result.proxyStatus),
+                            .downloadSize = static_cast<uint32_t>(result.downloadSize),
+                            .redirectUrl = std::move(result.redirectUrl),
+                            .body = std::move(body),
+                            .headers = std::move(result.headers)};
+                        response["bodyIsBase64"] = base64;
+                        response["headersAreBase64"] = headersBase64;
+                        // Separate from body, which the frontend converts as a string.
+                        if (bytes)
+                            response["bodyBytes"] =
+                                nlohmann::json::binary(std::vector<std::uint8_t>(result.body.begin(), result.body.end()));
+                        hub.respond(requestId, std::move(response));
+                    }
+                    catch (std::exception const& exc)
+                    {
+                        hub.respondWithError(requestId, exc.what());
+                    }
+                };
+
+                auto requestUrl = parsedUrl.value().toString(true, false);
+                if (!cache)
+                {
+                    client->start(requestId, std::move(requestUrl), options, std::move(onDone));
+                    return;
+                }
+
+                auto lookup = cache->lookup(requestUrl, options);
+                if (lookup.response)
+                {
+                    onDone(std::move(*lookup.response));
+                    return;
+                }
+                if (lookup.unsatisfiable)
+                {
+                    // As specified for only-if-cached in RFC 9111.
+                    onDone(FetchResult{
+                        .curlCode = CURLE_OK,
+                        .status = 504,
+                        .proxyStatus = 0,
+                        .downloadSize = 0,
+                        .redirectUrl = {},
+                        .body = {},
+                        .headers = {},
+                    });
+                    return;
+                }
+
+                auto requestOptions = options;
+                for (auto& [name, value] : lookup.conditionalHeaders)
+                    requestOptions.headers[name] = std::move(value);
+                client->start(
+                    requestId,
+                    requestUrl,
+                    std::move(requestOptions),
+                    [cache, requestUrl, options, onDone = std::move(onDone)](FetchResult&& result) {
+                        onDone(cache->complete(requestUrl, options, std::move(result)));
+                    });
+            },
+            RpcExecutionPolicy::onStrand("Nui::fetch"));
+        hub.registerFunction("Nui::cancelFetch", [client](std::uint32_t requestId) {
+            client->cancel(requestId);
+        });
+        hub.registerRequestHandler("Nui::fetchCacheStatistics", [cache]() {
+            return cache ? cache->statistics() : FetchCacheStatistics{};
+        });
     }
-}
\ No newline at end of file
+}
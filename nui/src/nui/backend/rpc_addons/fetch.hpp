@@ -1,8 +1,11 @@
 #pragma once
 
 #include <nui/backend/rpc_hub.hpp>
+#include <nui/backend/fetch_cache_options.hpp>
+
+#include <optional>
 
 namespace Nui
 {
-    void registerFetch(Nui::RpcHub const& hub);
+    void registerFetch(Nui::RpcHub const& hub, std::optional<FetchCacheOptions> const& cacheOptions = std::nullopt);
 }
\ No newline at end of file
@@ -0,0 +1,708 @@
+#include "fetch_cache.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+
+namespace Nui
+{
+    namespace
+    {
+        std::string toLower(std::string_view text)
+        {
+            std::string result{text};
+            std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+            return result;
+        }
+
+        std::string_view trim(std::string_view text)
+        {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+                text.remove_prefix(1);
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+                text.remove_suffix(1);
+            return text;
+        }
+
+        /// Header names are case insensitive.
+        std::optional<std::string>
+        findHeader(std::unordered_map<std::string, std::string> const& headers, std::string_view name)
+        {
+            for (auto const& [key, value] : headers)
+            {
+                if (toLower(key) == name)
+                    return value;
+            }
+            return std::nullopt;
+        }
+
+        template <typename FunctionT>
+        void forEachListElement(std::string_view list, FunctionT&& func)
+        {
+            while (!list.empty())
+            {
+                const auto comma = list.find(',');
+                const auto element = trim(list.substr(0, comma));
+                if (!element.empty())
+                    func(element);
+                if (comma == std::string_view::npos)
+                    break;
+                list.remove_prefix(comma + 1);
+            }
+        }
+
+        struct CacheControl
+        {
+            bool noStore = false;
+            bool noCache = false;
+            std::optional<std::int64_t> maxAge = std::nullopt;
+        };
+
+        CacheControl parseCacheControl(std::unordered_map<std::string, std::string> const& headers)
+        {
+            CacheControl cacheControl{};
+            if (const auto pragma = findHeader(headers, "pragma"); pragma && toLower(*pragma) == "no-cache")
+                cacheControl.noCache = true;
+            const auto header = findHeader(headers, "cache-control");
+            if (!header)
+                return cacheControl;
+
+            forEachListElement(*header, [&cacheControl](std::string_view directive) {
+                const auto equals = directive.find('=');
+                const auto name = toLower(trim(directive.substr(0, equals)));
+                auto argument =
+                    equals == std::string_view::npos ? std::string_view{} : trim(directive.substr(equals + 1));
+                if (argument.size() >= 2 && argument.front() == '"' && argument.back() == '"')
+                    argument = argument.substr(1, argument.size() - 2);
+
+                if (name == "no-store")
+                    cacheControl.noStore = true;
+                else if (name == "no-cache")
+                    cacheControl.noCache = true;
+                else if (name == "max-age")
+                {
+                    std::int64_t seconds = 0;
+                    for (const auto c : argument)
+                    {
+                        if (c < '0' || c > '9')
+                            return;
+                        seconds = std::min<std::int64_t>(seconds * 10 + (c - '0'), std::int64_t{1} << 40);
+                    }
+                    cacheControl.maxAge = seconds;
+                }
+            });
+            return cacheControl;
+        }
+
+        /// Days since 1970-01-01 of a date of the proleptic gregorian calendar.
+        std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day)
+        {
+            year -= month <= 2;
+            const auto era = (year >= 0 ? year : year - 399) / 400;
+            const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+            const auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+        }
+
+        /// Parses the preferred http date format, e.g. "Sun, 06 Nov 1994 08:49:37 GMT", to seconds since the epoch.
+        std::optional<std::int64_t> parseHttpDate(std::string const& text)
+        {
+            constexpr std::array<std::string_view, 12> months{
+                "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+            int day = 0;
+            char month[4] = {};
+            int year = 0;
+            int hour = 0;
+            int minute = 0;
+            int second = 0;
+            if (std::sscanf(
+                    text.c_str(), "%*3s, %2d %3s %4d %2d:%2d:%2d GMT", &day, month, &year, &hour, &minute, &second) !=
+                6)
+            {
+                return std::nullopt;
+            }
+            const auto monthIter = std::find(months.begin(), months.end(), std::string_view{month});
+            if (monthIter == months.end() || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60)
+                return std::nullopt;
+
+            const auto days = daysFromCivil(
+                year, static_cast<unsigned>(std::distance(months.begin(), monthIter) + 1), static_cast<unsigned>(day));
+            return days * 86400 + hour * 3600 + minute * 60 + second;
+        }
+
+        std::optional<std::int64_t>
+        findDateHeader(std::unordered_map<std::string, std::string> const& headers, std::string_view name)
+        {
+            if (const auto header = findHeader(headers, name))
+                return parseHttpDate(*header);
+            return std::nullopt;
+        }
+
+        std::int64_t secondsSinceEpoch()
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+
+        bool isHeuristicallyCacheable(long status)
+        {
+            constexpr std::array<long, 11> statuses{200, 203, 204, 300, 301, 308, 404, 405, 410, 414, 501};
+            return std::find(statuses.begin(), statuses.end(), status) != statuses.end();
+        }
+
+        bool isSafeMethod(std::string const& method)
+        {
+            return method.empty() || method == "GET" || method == "HEAD" || method == "OPTIONS" || method == "TRACE";
+        }
+
+        /// Stable across runs, unlike std::hash.
+        std::string fileNameOf(std::string const& url)
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (const auto c : url)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 0x100000001b3ull;
+            }
+            char name[17] = {};
+            std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+            return std::string{name} + ".entry";
+        }
+    }
+
+    struct FetchCache::Entry
+    {
+        std::string url;
+        long status;
+        std::string redirectUrl;
+        std::string body;
+        std::unordered_map<std::string, std::string> headers;
+        /// Lowercase names of the request headers listed in Vary, with the values of the stored request.
+        std::unordered_map<std::string, std::string> vary;
+        /// Seconds since the epoch when the response was received or last revalidated.
+        std::int64_t responseTime;
+        /// Age of the response when it was received, in seconds.
+        std::int64_t initialAge;
+        /// Seconds the response is fresh for, counting from its initial age.
+        std::int64_t lifetime;
+        /// Must be revalidated before every use.
+        bool noCache;
+
+        std::size_t size() const
+        {
+            std::size_t result = url.size() + redirectUrl.size() + body.size();
+            for (auto const& [name, value] : headers)
+                result += name.size() + value.size();
+            return result;
+        }
+
+        bool isFresh(std::int64_t now) const
+        {
+            return !noCache && lifetime > initialAge + std::max<std::int64_t>(0, now - responseTime);
+        }
+
+        bool matches(FetchOptions const& options) const
+        {
+            return std::all_of(vary.begin(), vary.end(), [&options](auto const& pair) {
+                return findHeader(options.headers, pair.first).value_or("") == pair.second;
+            });
+        }
+
+        FetchResult toResult() const
+        {
+            return FetchResult{
+                .curlCode = CURLE_OK,
+                .status = status,
+                .proxyStatus = 0,
+                .downloadSize = body.size(),
+                .redirectUrl = redirectUrl,
+                .body = body,
+                .headers = headers,
+            };
+        }
+
+        /// Computes age and lifetime from the headers. Returns false if the response may not be stored.
+        bool updateFreshness(std::int64_t now)
+        {
+            const auto cacheControl = parseCacheControl(headers);
+            if (cacheControl.noStore)
+                return false;
+
+            const auto date = findDateHeader(headers, "date");
+            std::int64_t age = 0;
+            if (const auto ageHeader = findHeader(headers, "age"))
+                age = std::max<std::int64_t>(0, std::atoll(ageHeader->c_str()));
+            responseTime = now;
+            initialAge = std::max<std::int64_t>(age, date ? now - *date : 0);
+            noCache = cacheControl.noCache;
+
+            const auto lastModified = findDateHeader(headers, "last-modified");
+            if (cacheControl.maxAge)
+                lifetime = *cacheControl.maxAge;
+            else if (const auto expires = findHeader(headers, "expires"))
+            {
+                // An invalid date like "0" means already expired.
+                const auto expiresAt = parseHttpDate(*expires);
+                lifetime = expiresAt ? *expiresAt - date.value_or(now) : 0;
+            }
+            else if (lastModified)
+                lifetime = (date.value_or(now) - *lastModified) / 10;
+            else
+                lifetime = 0;
+
+            const bool hasValidator = findHeader(headers, "etag") || lastModified;
+            return hasValidator || (lifetime > initialAge && !noCache);
+        }
+    };
+
+    // #####################################################################################################################
+    FetchCache::FetchCache(FetchCacheOptions options)
+        : options_{std::move(options)}
+        , memoryGuard_{}
+        , memory_{}
+        , memoryIndex_{}
+        , memoryBytes_{0}
+        , diskGuard_{}
+        , disk_{}
+        , diskIndex_{}
+        , diskBytes_{0}
+        , statistics_{}
+    {
+        if (options_.diskDirectory)
+            loadDiskIndex();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchCache::~FetchCache() = default;
+    //---------------------------------------------------------------------------------------------------------------------
+    bool FetchCache::bypasses(FetchOptions const& options)
+    {
+        if (options.method != "GET" && !options.method.empty())
+            return true;
+        if (options.cache == "no-store" || parseCacheControl(options.headers).noStore)
+            return true;
+        // The page handles these itself.
+        for (auto const& name :
+             {"if-none-match", "if-modified-since", "if-match", "if-unmodified-since", "if-range", "range"})
+        {
+            if (findHeader(options.headers, name))
+                return true;
+        }
+        return false;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchCache::Lookup FetchCache::lookup(std::string const& url, FetchOptions const& options)
+    {
+        Lookup lookup{
+            .response = std::nullopt,
+            .conditionalHeaders = {},
+            .unsatisfiable = false,
+        };
+        if (bypasses(options) || options.cache == "reload")
+            return lookup;
+
+        auto entry = find(url);
+        if (entry && !entry->matches(options))
+            entry.reset();
+        if (!entry)
+        {
+            if (options.cache == "only-if-cached")
+            {
+                lookup.unsatisfiable = true;
+                std::scoped_lock lock{memoryGuard_};
+                ++statistics_.misses;
+            }
+            return lookup;
+        }
+
+        const auto requestCacheControl = parseCacheControl(options.headers);
+        const bool revalidate = options.cache == "no-cache" || requestCacheControl.noCache ||
+            (requestCacheControl.maxAge && *requestCacheControl.maxAge == 0);
+        if (options.cache == "force-cache" || options.cache == "only-if-cached" ||
+            (!revalidate && entry->isFresh(secondsSinceEpoch())))
+        {
+            lookup.response = entry->toResult();
+            std::scoped_lock lock{memoryGuard_};
+            ++statistics_.hits;
+            return lookup;
+        }
+
+        if (const auto etag = findHeader(entry->headers, "etag"))
+            lookup.conditionalHeaders.emplace_back("If-None-Match", *etag);
+        if (const auto lastModified = findHeader(entry->headers, "last-modified"))
+            lookup.conditionalHeaders.emplace_back("If-Modified-Since", *lastModified);
+        return lookup;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchResult FetchCache::complete(std::string const& url, FetchOptions const& options, FetchResult&& result)
+    {
+        if (!isSafeMethod(options.method))
+        {
+            if (result.curlCode == CURLE_OK && result.status >= 200 && result.status < 400)
+                forget(url);
+            return std::move(result);
+        }
+        if (bypasses(options) || result.curlCode != CURLE_OK)
+            return std::move(result);
+
+        const auto now = secondsSinceEpoch();
+        if (result.status == 304)
+        {
+            if (auto stored = find(url); stored && stored->matches(options))
+            {
+                auto updated = std::make_shared<Entry>(*stored);
+                for (auto& [name, value] : result.headers)
+                {
+                    const auto lowerName = toLower(name);
+                    if (lowerName == "content-length" || lowerName == "transfer-encoding")
+                        continue;
+                    std::erase_if(updated->headers, [&lowerName](auto const& header) {
+                        return toLower(header.first) == lowerName;
+                    });
+                    updated->headers.emplace(name, std::move(value));
+                }
+                if (updated->updateFreshness(now))
+                    store(updated, options.cacheOnDisk);
+                else
+                    forget(url);
+
+                std::scoped_lock lock{memoryGuard_};
+                ++statistics_.revalidations;
+                return updated->toResult();
+            }
+        }
+
+        {
+            std::scoped_lock lock{memoryGuard_};
+            ++statistics_.misses;
+        }
+
+        auto entry = std::make_shared<Entry>(Entry{
+            .url = url,
+            .status = result.status,
+            .redirectUrl = result.redirectUrl,
+            .body = result.body,
+            .headers = result.headers,
+            .vary = {},
+            .responseTime = now,
+            .initialAge = 0,
+            .lifetime = 0,
+            .noCache = false,
+        });
+        bool storable = isHeuristicallyCacheable(result.status) && entry->updateFreshness(now);
+        if (const auto vary = findHeader(result.headers, "vary"); storable && vary)
+        {
+            forEachListElement(*vary, [&entry, &options, &storable](std::string_view name) {
+                if (name == "*")
+                    storable = false;
+                const auto lowerName = toLower(name);
+                entry->vary[lowerName] = findHeader(options.headers, lowerName).value_or("");
+            });
+        }
+
+        if (storable)
+            store(entry, options.cacheOnDisk);
+        else
+            forget(url);
+        return std::move(result);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchCacheStatistics FetchCache::statistics() const
+    {
+        FetchCacheStatistics statistics{};
+        {
+            std::scoped_lock lock{memoryGuard_};
+            statistics = statistics_;
+            statistics.memoryEntries = static_cast<std::uint32_t>(memory_.size());
+            statistics.memoryBytes = static_cast<double>(memoryBytes_);
+        }
+        {
+            std::scoped_lock lock{diskGuard_};
+            statistics.diskEntries = static_cast<std::uint32_t>(disk_.size());
+            statistics.diskBytes = static_cast<double>(diskBytes_);
+        }
+        return statistics;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::clear()
+    {
+        {
+            std::scoped_lock lock{memoryGuard_};
+            memory_.clear();
+            memoryIndex_.clear();
+            memoryBytes_ = 0;
+        }
+        if (!options_.diskDirectory)
+            return;
+        std::scoped_lock lock{diskGuard_};
+        for (auto const& file : disk_)
+        {
+            std::error_code ec;
+            std::filesystem::remove(*options_.diskDirectory / file.name, ec);
+        }
+        disk_.clear();
+        diskIndex_.clear();
+        diskBytes_ = 0;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::shared_ptr<FetchCache::Entry const> FetchCache::find(std::string const& url)
+    {
+        {
+            std::scoped_lock lock{memoryGuard_};
+            if (auto iter = memoryIndex_.find(url); iter != memoryIndex_.end())
+            {
+                memory_.splice(memory_.begin(), memory_, iter->second);
+                return *iter->second;
+            }
+        }
+        auto entry = readFromDisk(url);
+        if (entry)
+            remember(entry);
+        return entry;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::remember(std::shared_ptr<Entry const> const& entry)
+    {
+        std::scoped_lock lock{memoryGuard_};
+        if (auto iter = memoryIndex_.find(entry->url); iter != memoryIndex_.end())
+        {
+            memoryBytes_ -= (*iter->second)->size();
+            memory_.erase(iter->second);
+            memoryIndex_.erase(iter);
+        }
+
+        const auto size = entry->size();
+        if (size > options_.memoryBudget)
+            return;
+        while (memoryBytes_ + size > options_.memoryBudget)
+        {
+            memoryBytes_ -= memory_.back()->size();
+            memoryIndex_.erase(memory_.back()->url);
+            memory_.pop_back();
+            ++statistics_.evictions;
+        }
+        memory_.push_front(entry);
+        memoryIndex_[entry->url] = memory_.begin();
+        memoryBytes_ += size;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::forget(std::string const& url)
+    {
+        {
+            std::scoped_lock lock{memoryGuard_};
+            if (auto iter = memoryIndex_.find(url); iter != memoryIndex_.end())
+            {
+                memoryBytes_ -= (*iter->second)->size();
+                memory_.erase(iter->second);
+                memoryIndex_.erase(iter);
+            }
+        }
+        removeFromDisk(url);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::store(std::shared_ptr<Entry const> const& entry, bool onDisk)
+    {
+        remember(entry);
+        if (onDisk)
+            writeToDisk(*entry);
+        else
+            removeFromDisk(entry->url);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::filesystem::path FetchCache::diskPath(std::string const& url) const
+    {
+        return *options_.diskDirectory / fileNameOf(url);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::shared_ptr<FetchCache::Entry const> FetchCache::readFromDisk(std::string const& url)
+    {
+        if (!options_.diskDirectory)
+            return nullptr;
+
+        std::scoped_lock lock{diskGuard_};
+        const auto iter = diskIndex_.find(fileNameOf(url));
+        if (iter == diskIndex_.end())
+            return nullptr;
+
+        // A file holds one line of json with everything but the body, followed by the body.
+        std::ifstream reader{diskPath(url), std::ios::binary};
+        std::string metaLine;
+        if (!reader || !std::getline(reader, metaLine))
+            return nullptr;
+        const auto meta = nlohmann::json::parse(metaLine, nullptr, false);
+        if (meta.is_discarded() || !meta.is_object() || meta.value("url", "") != url)
+            return nullptr;
+
+        try
+        {
+            auto entry = std::make_shared<Entry>(Entry{
+                .url = url,
+                .status = meta["status"].get<long>(),
+                .redirectUrl = meta["redirectUrl"].get<std::string>(),
+                .body = std::string{std::istreambuf_iterator<char>{reader}, std::istreambuf_iterator<char>{}},
+                .headers = meta["headers"].get<std::unordered_map<std::string, std::string>>(),
+                .vary = meta["vary"].get<std::unordered_map<std::string, std::string>>(),
+                .responseTime = meta["responseTime"].get<std::int64_t>(),
+                .initialAge = meta["initialAge"].get<std::int64_t>(),
+                .lifetime = meta["lifetime"].get<std::int64_t>(),
+                .noCache = meta["noCache"].get<bool>(),
+            });
+            disk_.splice(disk_.begin(), disk_, iter->second);
+            return entry;
+        }
+        catch (nlohmann::json::exception const&)
+        {
+            return nullptr;
+        }
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::writeToDisk(Entry const& entry)
+    {
+        if (!options_.diskDirectory)
+            return;
+
+        // Headers are raw bytes from the server, serializing them fails if they are not valid UTF-8. Such responses
+        // are not stored and an older copy of the url is dropped.
+        std::optional<std::string> meta;
+        try
+        {
+            meta = nlohmann::json{
+                {"url", entry.url},
+                {"status", entry.status},
+                {"redirectUrl", entry.redirectUrl},
+                {"headers", entry.headers},
+                {"vary", entry.vary},
+                {"responseTime", entry.responseTime},
+                {"initialAge", entry.initialAge},
+                {"lifetime", entry.lifetime},
+                {"noCache", entry.noCache},
+            }
+                       .dump();
+        }
+        catch (nlohmann::json::exception const&)
+        {}
+        const auto size = meta ? meta->size() + 1 + entry.body.size() : 0;
+        const auto name = fileNameOf(entry.url);
+        const auto path = diskPath(entry.url);
+
+        std::scoped_lock lock{diskGuard_};
+        if (auto iter = diskIndex_.find(name); iter != diskIndex_.end())
+        {
+            diskBytes_ -= iter->second->size;
+            disk_.erase(iter->second);
+            diskIndex_.erase(iter);
+        }
+
+        std::error_code ec;
+        if (!meta || size > options_.diskBudget)
+        {
+            std::filesystem::remove(path, ec);
+            return;
+        }
+
+        // Written next to the target and renamed, so that a crash never leaves a partial entry behind.
+        auto temporary = path;
+        temporary += ".tmp";
+        {
+            std::ofstream writer{temporary, std::ios::binary | std::ios::trunc};
+            writer << *meta << '\n';
+            writer.write(entry.body.data(), static_cast<std::streamsize>(entry.body.size()));
+            if (!writer)
+            {
+                writer.close();
+                std::filesystem::remove(temporary, ec);
+                return;
+            }
+        }
+        std::filesystem::rename(temporary, path, ec);
+        if (ec)
+        {
+            std::filesystem::remove(temporary, ec);
+            return;
+        }
+
+        while (diskBytes_ + size > options_.diskBudget)
+        {
+            std::filesystem::remove(*options_.diskDirectory / disk_.back().name, ec);
+            diskBytes_ -= disk_.back().size;
+            diskIndex_.erase(disk_.back().name);
+            disk_.pop_back();
+        }
+        disk_.push_front(DiskFile{.name = name, .size = size});
+        diskIndex_[name] = disk_.begin();
+        diskBytes_ += size;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::removeFromDisk(std::string const& url)
+    {
+        if (!options_.diskDirectory)
+            return;
+
+        std::scoped_lock lock{diskGuard_};
+        if (auto iter = diskIndex_.find(fileNameOf(url)); iter != diskIndex_.end())
+        {
+            std::error_code ec;
+            std::filesystem::remove(*options_.diskDirectory / iter->first, ec);
+            diskBytes_ -= iter->second->size;
+            disk_.erase(iter->second);
+            diskIndex_.erase(iter);
+        }
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchCache::loadDiskIndex()
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(*options_.diskDirectory, ec);
+
+        struct Found
+        {
+            DiskFile file;
+            std::filesystem::file_time_type lastWrite;
+        };
+        std::vector<Found> found;
+        for (auto const& item : std::filesystem::directory_iterator{*options_.diskDirectory, ec})
+        {
+            if (!item.is_regular_file(ec))
+                continue;
+            const auto extension = item.path().extension();
+            if (extension == ".tmp")
+                std::filesystem::remove(item.path(), ec);
+            else if (extension == ".entry")
+            {
+                found.push_back(Found{
+                    .file = DiskFile{.name = item.path().filename().string(), .size = item.file_size(ec)},
+                    .lastWrite = item.last_write_time(ec),
+                });
+            }
+        }
+        // The least recently written are evicted first.
+        std::sort(found.begin(), found.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.lastWrite > rhs.lastWrite;
+        });
+
+        std::scoped_lock lock{diskGuard_};
+        for (auto& [file, lastWrite] : found)
+        {
+            if (diskBytes_ + file.size > options_.diskBudget)
+            {
+                std::filesystem::remove(*options_.diskDirectory / file.name, ec);
+                continue;
+            }
+            diskBytes_ += file.size;
+            disk_.push_back(std::move(file));
+            diskIndex_[disk_.back().name] = std::prev(disk_.end());
+        }
+    }
+    // #####################################################################################################################
+}
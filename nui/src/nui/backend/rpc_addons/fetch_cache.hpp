@@ -0,0 +1,107 @@
+#pragma once
+
+#include "fetch_client.hpp"
+
+#include <nui/backend/fetch_cache_options.hpp>
+#include <nui/shared/api/fetch_options.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Nui
+{
+    /**
+     * @brief A private http cache (RFC 9111) for the responses of FetchClient. Responses are kept in a memory LRU
+     * and optionally in a disk directory. Stale responses are revalidated with ETag and Last-Modified.
+     *
+     * Only GET requests are cached. Every function is threadsafe.
+     */
+    class FetchCache
+    {
+      public:
+        struct Lookup
+        {
+            /// Set when the request can be answered without the server.
+            std::optional<FetchResult> response;
+            /// Validators of a stale response, the request must carry them and be passed to complete.
+            std::vector<std::pair<std::string, std::string>> conditionalHeaders;
+            /// The request must not go to the network (only-if-cached), but nothing is cached.
+            bool unsatisfiable;
+        };
+
+        explicit FetchCache(FetchCacheOptions options);
+        ~FetchCache();
+        FetchCache(FetchCache const&) = delete;
+        FetchCache& operator=(FetchCache const&) = delete;
+        FetchCache(FetchCache&&) = delete;
+        FetchCache& operator=(FetchCache&&) = delete;
+
+        /**
+         * @brief Looks for a usable response before a request is made.
+         *
+         * @param url The url of the request.
+         * @param options The options of the request, its method, headers and cache mode decide what is usable.
+         */
+        Lookup lookup(std::string const& url, FetchOptions const& options);
+
+        /**
+         * @brief Passes the result of a request through the cache. Stores cacheable responses, invalidates the url
+         * for successful unsafe methods and turns a 304 to a conditional request into the cached response.
+         *
+         * @return FetchResult The response for the frontend.
+         */
+        FetchResult complete(std::string const& url, FetchOptions const& options, FetchResult&& result);
+
+        FetchCacheStatistics statistics() const;
+
+        /**
+         * @brief Drops all responses from memory and disk.
+         */
+        void clear();
+
+      private:
+        struct Entry;
+        struct DiskFile
+        {
+            std::string name;
+            std::uintmax_t size;
+        };
+
+        static bool bypasses(FetchOptions const& options);
+        std::shared_ptr<Entry const> find(std::string const& url);
+        void remember(std::shared_ptr<Entry const> const& entry);
+        void forget(std::string const& url);
+        void store(std::shared_ptr<Entry const> const& entry, bool onDisk);
+
+        std::shared_ptr<Entry const> readFromDisk(std::string const& url);
+        void writeToDisk(Entry const& entry);
+        void removeFromDisk(std::string const& url);
+        void loadDiskIndex();
+        std::filesystem::path diskPath(std::string const& url) const;
+
+      private:
+        FetchCacheOptions options_;
+
+        mutable std::mutex memoryGuard_;
+        /// Most recently used first.
+        std::list<std::shared_ptr<Entry const>> memory_;
+        std::unordered_map<std::string, std::list<std::shared_ptr<Entry const>>::iterator> memoryIndex_;
+        std::size_t memoryBytes_;
+
+        mutable std::mutex diskGuard_;
+        /// Most recently used first.
+        std::list<DiskFile> disk_;
+        std::unordered_map<std::string, std::list<DiskFile>::iterator> diskIndex_;
+        std::uintmax_t diskBytes_;
+
+        FetchCacheStatistics statistics_;
+    };
+}
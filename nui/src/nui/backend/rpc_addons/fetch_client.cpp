@@ -0,0 +1,411 @@
+#include "fetch_client.hpp"
+
+#include <boost/asio/post.hpp>
+#ifndef _WIN32
+#    include <boost/asio/posix/stream_descriptor.hpp>
+#    include <unistd.h>
+#endif
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+namespace Nui
+{
+    struct FetchClient::Transfer
+    {
+        std::uint64_t id;
+        std::string url;
+        FetchOptions options;
+        CompletionHandler onDone;
+        CURL* easy{nullptr};
+        curl_slist* headerList{nullptr};
+        std::string body{};
+        std::unordered_map<std::string, std::string> headers{};
+    };
+
+#ifndef _WIN32
+    /// Watches a duplicate of a curl socket, so that closing it never closes the socket of curl.
+    struct FetchClient::Socket
+    {
+        curl_socket_t native;
+        boost::asio::posix::stream_descriptor descriptor;
+        int what{0};
+        bool readPending{false};
+        bool writePending{false};
+    };
+#else
+    struct FetchClient::Socket
+    {};
+#endif
+
+    // #####################################################################################################################
+    FetchClient::FetchClient(boost::asio::any_io_executor executor)
+        : FetchClient{std::move(executor), Limits{}}
+    {}
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchClient::FetchClient(boost::asio::any_io_executor executor, Limits limits)
+        : strand_{boost::asio::make_strand(std::move(executor))}
+        , timer_{strand_}
+        , limits_{limits}
+        , multi_{curl_multi_init()}
+        , running_{}
+        , queued_{}
+        , idleHandles_{}
+        , sockets_{}
+    {
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, limits_.maxConnectionsPerHost);
+        curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS, limits_.maxTotalConnections);
+        curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS, limits_.maxTotalConnections);
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#ifndef _WIN32
+        curl_multi_setopt(multi_, CURLMOPT_SOCKETFUNCTION, &FetchClient::onSocket);
+        curl_multi_setopt(multi_, CURLMOPT_SOCKETDATA, this);
+        curl_multi_setopt(multi_, CURLMOPT_TIMERFUNCTION, &FetchClient::onTimer);
+        curl_multi_setopt(multi_, CURLMOPT_TIMERDATA, this);
+#endif
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    FetchClient::~FetchClient()
+    {
+        timer_.cancel();
+        for (auto& [id, transfer] : running_)
+        {
+            curl_multi_remove_handle(multi_, transfer->easy);
+            curl_slist_free_all(transfer->headerList);
+            curl_easy_cleanup(transfer->easy);
+        }
+        for (auto* easy : idleHandles_)
+            curl_easy_cleanup(easy);
+        curl_multi_cleanup(multi_);
+        sockets_.clear();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::start(std::uint64_t id, std::string url, FetchOptions options, CompletionHandler onDone)
+    {
+        auto transfer = std::make_shared<Transfer>(Transfer{
+            .id = id,
+            .url = std::move(url),
+            .options = std::move(options),
+            .onDone = std::move(onDone),
+        });
+        boost::asio::post(strand_, [this, transfer = std::move(transfer)]() {
+            // An id that is still in use belongs to a page that was reloaded meanwhile.
+            if (running_.contains(transfer->id))
+                release(*running_.extract(transfer->id).mapped());
+            std::erase_if(queued_, [id = transfer->id](auto const& queued) {
+                return queued->id == id;
+            });
+
+            queued_.push_back(std::make_unique<Transfer>(std::move(*transfer)));
+            startQueued();
+        });
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::cancel(std::uint64_t id)
+    {
+        boost::asio::post(strand_, [this, id]() {
+            std::erase_if(queued_, [id](auto const& queued) {
+                return queued->id == id;
+            });
+            if (auto iter = running_.find(id); iter != running_.end())
+            {
+                release(*iter->second);
+                running_.erase(iter);
+                startQueued();
+            }
+        });
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::startQueued()
+    {
+        const bool wasIdle = running_.empty();
+        while (running_.size() < limits_.maxConcurrentRequests && !queued_.empty())
+        {
+            auto transfer = std::move(queued_.front());
+            queued_.pop_front();
+
+            configure(*transfer);
+            if (const auto code = curl_multi_add_handle(multi_, transfer->easy); code != CURLM_OK)
+            {
+                auto onDone = std::move(transfer->onDone);
+                release(*transfer);
+                onDone(FetchResult{
+                    .curlCode = CURLE_FAILED_INIT,
+                    .status = 0,
+                    .proxyStatus = 0,
+                    .downloadSize = 0,
+                    .redirectUrl = {},
+                    .body = {},
+                    .headers = {},
+                });
+                continue;
+            }
+            const auto id = transfer->id;
+            running_.emplace(id, std::move(transfer));
+        }
+#ifdef _WIN32
+        if (wasIdle && !running_.empty())
+            poll();
+#else
+        (void)wasIdle;
+#endif
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::configure(Transfer& transfer)
+    {
+        if (idleHandles_.empty())
+            transfer.easy = curl_easy_init();
+        else
+        {
+            transfer.easy = idleHandles_.back();
+            idleHandles_.pop_back();
+        }
+
+        auto* easy = transfer.easy;
+        auto const& options = transfer.options;
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, &transfer);
+        curl_easy_setopt(easy, CURLOPT_URL, transfer.url.c_str());
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, &FetchClient::onBody);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, &FetchClient::onHeader);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer);
+        curl_easy_setopt(easy, CURLOPT_VERBOSE, options.verbose ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, options.followRedirects ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_MAXREDIRS, options.maxRedirects);
+        curl_easy_setopt(easy, CURLOPT_AUTOREFERER, options.autoReferer ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, options.verifyPeer ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, options.verifyHost ? 2L : 0L);
+
+        if (!options.body.empty() && options.method != "GET")
+        {
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(options.body.size()));
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, options.body.data());
+        }
+        if (options.method == "HEAD")
+            curl_easy_setopt(easy, CURLOPT_NOBODY, 1L);
+        else if (options.method != "GET" && !options.method.empty())
+            curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, options.method.c_str());
+
+        for (auto const& [name, value] : options.headers)
+            transfer.headerList = curl_slist_append(transfer.headerList, (name + ": " + value).c_str());
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer.headerList);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::release(Transfer& transfer)
+    {
+        if (!transfer.easy)
+            return;
+        curl_multi_remove_handle(multi_, transfer.easy);
+        curl_slist_free_all(transfer.headerList);
+        transfer.headerList = nullptr;
+        curl_easy_reset(transfer.easy);
+        if (idleHandles_.size() < limits_.maxConcurrentRequests)
+            idleHandles_.push_back(transfer.easy);
+        else
+            curl_easy_cleanup(transfer.easy);
+        transfer.easy = nullptr;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::finish(CURL* easy, CURLcode result)
+    {
+        char* privateData = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &privateData);
+        auto iter = running_.find(reinterpret_cast<Transfer*>(privateData)->id);
+        if (iter == running_.end())
+            return;
+        auto transfer = std::move(iter->second);
+        running_.erase(iter);
+
+        long status = 0;
+        long proxyStatus = 0;
+        curl_off_t downloadSize = 0;
+        char* redirectUrl = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &status);
+        curl_easy_getinfo(easy, CURLINFO_HTTP_CONNECTCODE, &proxyStatus);
+        curl_easy_getinfo(easy, CURLINFO_SIZE_DOWNLOAD_T, &downloadSize);
+        curl_easy_getinfo(easy, CURLINFO_REDIRECT_URL, &redirectUrl);
+        FetchResult fetchResult{
+            .curlCode = result,
+            .status = status,
+            .proxyStatus = proxyStatus,
+            .downloadSize = static_cast<std::uint64_t>(downloadSize),
+            .redirectUrl = redirectUrl ? redirectUrl : "",
+            .body = std::move(transfer->body),
+            .headers = std::move(transfer->headers),
+        };
+        release(*transfer);
+        // This runs on a pool thread, an escaping exception would terminate the process.
+        try
+        {
+            transfer->onDone(std::move(fetchResult));
+        }
+        catch (std::exception const& exc)
+        {
+            std::cerr << "Fetch completion handler failed: " << exc.what() << "\n";
+        }
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::socketAction(curl_socket_t socket, int events)
+    {
+        int running = 0;
+        curl_multi_socket_action(multi_, socket, events, &running);
+        checkCompleted();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::checkCompleted()
+    {
+        int remaining = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi_, &remaining))
+        {
+            if (message->msg == CURLMSG_DONE)
+                finish(message->easy_handle, message->data.result);
+        }
+        startQueued();
+    }
+#ifndef _WIN32
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::watch(curl_socket_t socket, int what)
+    {
+        auto iter = sockets_.find(socket);
+        if (what == CURL_POLL_REMOVE)
+        {
+            if (iter != sockets_.end())
+            {
+                boost::system::error_code ignored;
+                iter->second->descriptor.close(ignored);
+                sockets_.erase(iter);
+            }
+            return;
+        }
+
+        if (iter == sockets_.end())
+        {
+            const int duplicate = ::dup(socket);
+            if (duplicate < 0)
+                return;
+            iter = sockets_
+                       .emplace(
+                           socket,
+                           std::make_shared<Socket>(Socket{
+                               .native = socket,
+                               .descriptor = boost::asio::posix::stream_descriptor{strand_, duplicate},
+                           }))
+                       .first;
+        }
+        auto socketInfo = iter->second;
+        socketInfo->what = what;
+        if ((what & CURL_POLL_IN) && !socketInfo->readPending)
+            wait(socketInfo, false);
+        if ((what & CURL_POLL_OUT) && !socketInfo->writePending)
+            wait(socketInfo, true);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::wait(std::shared_ptr<Socket> const& socket, bool forWrite)
+    {
+        (forWrite ? socket->writePending : socket->readPending) = true;
+        socket->descriptor.async_wait(
+            forWrite ? boost::asio::posix::stream_descriptor::wait_write
+                     : boost::asio::posix::stream_descriptor::wait_read,
+            [this, weak = std::weak_ptr<Socket>{socket}, native = socket->native, forWrite](
+                boost::system::error_code const& ec) {
+                auto socket = weak.lock();
+                if (!socket)
+                    return;
+                (forWrite ? socket->writePending : socket->readPending) = false;
+                if (ec)
+                    return;
+
+                socketAction(native, forWrite ? CURL_CSELECT_OUT : CURL_CSELECT_IN);
+
+                // curl may have changed or removed the watch meanwhile.
+                auto iter = sockets_.find(native);
+                if (iter == sockets_.end() || iter->second != socket)
+                    return;
+                const bool wanted = socket->what & (forWrite ? CURL_POLL_OUT : CURL_POLL_IN);
+                const bool pending = forWrite ? socket->writePending : socket->readPending;
+                if (wanted && !pending)
+                    wait(socket, forWrite);
+            });
+    }
+#else
+    //---------------------------------------------------------------------------------------------------------------------
+    void FetchClient::poll()
+    {
+        // Without socket notifications on windows, the transfers are driven by a short timer while any is running.
+        int running = 0;
+        curl_multi_perform(multi_, &running);
+        checkCompleted();
+        if (running_.empty())
+            return;
+        timer_.expires_after(std::chrono::milliseconds{1});
+        timer_.async_wait([this](boost::system::error_code const& ec) {
+            if (!ec)
+                poll();
+        });
+    }
+#endif
+    //---------------------------------------------------------------------------------------------------------------------
+    int FetchClient::onSocket(CURL*, curl_socket_t socket, int what, void* userData, void*)
+    {
+#ifndef _WIN32
+        static_cast<FetchClient*>(userData)->watch(socket, what);
+#else
+        (void)socket;
+        (void)what;
+        (void)userData;
+#endif
+        return 0;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    int FetchClient::onTimer(CURLM*, long timeoutMs, void* userData)
+    {
+        auto* self = static_cast<FetchClient*>(userData);
+        if (timeoutMs < 0)
+        {
+            self->timer_.cancel();
+            return 0;
+        }
+        // Must not call into curl from this callback, so even a zero timeout goes through the timer.
+        self->timer_.expires_after(std::chrono::milliseconds{timeoutMs});
+        self->timer_.async_wait([self](boost::system::error_code const& ec) {
+            if (!ec)
+                self->socketAction(CURL_SOCKET_TIMEOUT, 0);
+        });
+        return 0;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::size_t FetchClient::onBody(char* data, std::size_t size, std::size_t count, void* userData)
+    {
+        static_cast<Transfer*>(userData)->body.append(data, size * count);
+        return size * count;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::size_t FetchClient::onHeader(char* data, std::size_t size, std::size_t count, void* userData)
+    {
+        auto* transfer = static_cast<Transfer*>(userData);
+        auto line = std::string_view{data, size * count};
+        while (!line.empty() && (line.back() == '\r' || line.back() == '\n'))
+            line.remove_suffix(1);
+
+        // Every response of a redirect chain starts with a status line, only the headers of the last are kept.
+        if (line.starts_with("HTTP/"))
+        {
+            transfer->headers.clear();
+            return size * count;
+        }
+        const auto colon = line.find(':');
+        if (colon == std::string_view::npos)
+            return size * count;
+        auto value = line.substr(colon + 1);
+        while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+            value.remove_prefix(1);
+        transfer->headers[std::string{line.substr(0, colon)}] = std::string{value};
+        return size * count;
+    }
+    // #####################################################################################################################
+}
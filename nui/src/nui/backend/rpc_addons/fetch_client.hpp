@@ -0,0 +1,109 @@
+#pragma once
+
+#include <nui/shared/api/fetch_options.hpp>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/high_resolution_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <curl/curl.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Nui
+{
+    struct FetchResult
+    {
+        CURLcode curlCode;
+        long status;
+        long proxyStatus;
+        std::uint64_t downloadSize;
+        std::string redirectUrl;
+        std::string body;
+        std::unordered_map<std::string, std::string> headers;
+    };
+
+    /**
+     * @brief Runs many requests concurrently on one curl multi handle, driven by an executor instead of a blocking
+     * perform per request. Connections are kept open and reused for following requests to the same host.
+     *
+     * All curl calls happen on a strand of the given executor. Public functions may be called from any thread. The
+     * client must be destroyed when no handlers of the executor run anymore, e.g. after its thread pool was joined.
+     */
+    class FetchClient
+    {
+      public:
+        using CompletionHandler = std::function<void(FetchResult&&)>;
+
+        struct Limits
+        {
+            /// Requests beyond this are queued until a running one finishes.
+            std::size_t maxConcurrentRequests = 16;
+            long maxConnectionsPerHost = 6;
+            /// Also the amount of idle connections that are kept for reuse.
+            long maxTotalConnections = 32;
+        };
+
+        explicit FetchClient(boost::asio::any_io_executor executor);
+        FetchClient(boost::asio::any_io_executor executor, Limits limits);
+        ~FetchClient();
+        FetchClient(FetchClient const&) = delete;
+        FetchClient& operator=(FetchClient const&) = delete;
+        FetchClient(FetchClient&&) = delete;
+        FetchClient& operator=(FetchClient&&) = delete;
+
+        /**
+         * @brief Starts the request, or queues it when the concurrency limit is reached.
+         *
+         * @param id Identifies the request for cancel.
+         * @param url The url to fetch.
+         * @param options Method, headers, body, etc.
+         * @param onDone Called on the strand of the client when the request is complete or failed. Exceptions
+         * thrown by it are logged and swallowed, it should answer the request itself if it fails.
+         */
+        void start(std::uint64_t id, std::string url, FetchOptions options, CompletionHandler onDone);
+
+        /**
+         * @brief Aborts a running or queued request. Its completion handler is not called.
+         */
+        void cancel(std::uint64_t id);
+
+      private:
+        struct Transfer;
+        struct Socket;
+
+        void startQueued();
+        void configure(Transfer& transfer);
+        void finish(CURL* easy, CURLcode result);
+        void release(Transfer& transfer);
+        void socketAction(curl_socket_t socket, int events);
+        void checkCompleted();
+#ifndef _WIN32
+        void watch(curl_socket_t socket, int what);
+        void wait(std::shared_ptr<Socket> const& socket, bool forWrite);
+#else
+        void poll();
+#endif
+
+        static int onSocket(CURL* easy, curl_socket_t socket, int what, void* userData, void* socketData);
+        static int onTimer(CURLM* multi, long timeoutMs, void* userData);
+        static std::size_t onBody(char* data, std::size_t size, std::size_t count, void* userData);
+        static std::size_t onHeader(char* data, std::size_t size, std::size_t count, void* userData);
+
+      private:
+        boost::asio::strand<boost::asio::any_io_executor> strand_;
+        boost::asio::high_resolution_timer timer_;
+        Limits limits_;
+        CURLM* multi_;
+        std::unordered_map<std::uint64_t, std::unique_ptr<Transfer>> running_;
+        std::deque<std::unique_ptr<Transfer>> queued_;
+        /// Reset easy handles of finished transfers, reusing them avoids setting up new ones.
+        std::vector<CURL*> idleHandles_;
+        std::unordered_map<curl_socket_t, std::shared_ptr<Socket>> sockets_;
+    };
+}
@@ -1,9 +1,15 @@
 #include "file.hpp"
 
 #include <nui/data_structures/selectables_registry.hpp>
+#include <nui/utility/base64.hpp>
 
-#include <string>
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace Nui
 {
@@ -30,70 +36,114 @@ namespace Nui
             return *static_cast<FileStreamStore*>(
                 hub.template accessStateStore<FileStreamStoreCreator>(fileStreamStoreId));
         }
+
+        std::fstream& getStream(auto& hub, int32_t id)
+        {
+            auto& store = getStore(hub);
+            auto iter = store.get(static_cast<FileStreamStore::IdType>(id));
+            if (iter == store.end() || !iter->item)
+                throw std::invalid_argument("No open file with id " + std::to_string(id));
+            return *iter->item;
+        }
+
+        /// Upper bound for chunks, so that a single response never has to hold a huge file.
+        constexpr std::uint32_t maxChunkSize = 16 * 1024 * 1024;
+
+        /// Binary over the binary rpc transport (MessagePack bin), base64 when calls are evaluated as scripts.
+        nlohmann::json encodeChunk(Nui::RpcHub const& hub, std::string const& data)
+        {
+            if (hub.window().binaryRpcTransportEnabled())
+                return nlohmann::json::binary(std::vector<std::uint8_t>(data.begin(), data.end()));
+            return base64Encode(data);
+        }
     }
 
     void registerFile(Nui::RpcHub& hub)
     {
-        hub.registerFunction(
-            "Nui::openFile", [&hub](std::string const& responseId, std::string const& fileName, int openMode) {
+        // Streams are not threadsafe, all file functions run one after another off the main loop.
+        const auto policy = RpcExecutionPolicy::onStrand("Nui::file");
+
+        hub.registerRequestHandler(
+            "Nui::openFile",
+            [&hub](std::string const& fileName, int openMode) -> nlohmann::json {
                 auto& store = Detail::getStore(hub);
                 std::fstream stream(fileName, static_cast<std::ios_base::openmode>(openMode));
                 if (!stream.is_open())
+                    return nlohmann::json{{"success", false}};
+
+                return nlohmann::json{{"success", true}, {"id", store.append(std::move(stream))}};
+            },
+            policy);
+        hub.registerFunction(
+            "Nui::closeFile",
+            [&hub](int32_t id) {
+                auto& store = Detail::getStore(hub);
+                store.erase(static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id));
+            },
+            policy);
+        // Positions are 64 bit, the frontend sends them as doubles which are exact up to 2^53.
+        hub.registerRequestHandler(
+            "Nui::tellg",
+            [&hub](int32_t id) {
+                return static_cast<std::int64_t>(Detail::getStream(hub, id).tellg());
+            },
+            policy);
+        hub.registerRequestHandler(
+            "Nui::tellp",
+            [&hub](int32_t id) {
+                return static_cast<std::int64_t>(Detail::getStream(hub, id).tellp());
+            },
+            policy);
+        hub.registerRequestHandler(
+            "Nui::seekg",
+            [&hub](int32_t id, std::int64_t pos, int32_t dir) {
+                Detail::getStream(hub, id).seekg(pos, static_cast<std::ios_base::seekdir>(dir));
+            },
+            policy);
+        hub.registerRequestHandler(
+            "Nui::seekp",
+            [&hub](int32_t id, std::int64_t pos, int32_t dir) {
+                Detail::getStream(hub, id).seekp(pos, static_cast<std::ios_base::seekdir>(dir));
+            },
+            policy);
+        // The frontend pulls one chunk per request, so no more than requested is ever read or buffered.
+        hub.registerRequestHandler(
+            "Nui::readChunk",
+            [&hub](int32_t id, std::uint32_t maxSize) {
+                auto& stream = Detail::getStream(hub, id);
+                std::string buffer(std::min(maxSize, Detail::maxChunkSize), '\0');
+                stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.resize(static_cast<std::size_t>(stream.gcount()));
+                const bool end = stream.eof() || stream.peek() == std::fstream::traits_type::eof();
+                // Reaching the end sets eof and fail, which would make following seeks fail.
+                stream.clear();
+                return nlohmann::json{{"data", Detail::encodeChunk(hub, buffer)}, {"end", end}};
+            },
+            policy);
+        hub.registerRequestHandler(
+            "Nui::write",
+            [&hub](int32_t id, nlohmann::json const& data) {
+                auto& stream = Detail::getStream(hub, id);
+                // Binary over the binary rpc transport, base64 when the call was stringified.
+                if (data.is_binary())
                 {
-                    hub.callRemote(responseId, nlohmann::json{{"success", false}});
-                    return;
+                    auto const& bytes = data.get_binary();
+                    stream.write(
+                        reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
                 }
-
-                hub.callRemote(responseId, nlohmann::json{{"success", true}, {"id", store.append(std::move(stream))}});
-            });
-        hub.registerFunction("Nui::closeFile", [&hub](int32_t id) {
-            auto& store = Detail::getStore(hub);
-            store.erase(static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id));
-        });
-        hub.registerFunction("Nui::tellg", [&hub](std::string const& responseId, int32_t id) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            hub.callRemote(responseId, static_cast<std::streamsize>(stream.item->tellg()));
-        });
-        hub.registerFunction("Nui::tellp", [&hub](std::string const& responseId, int32_t id) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            hub.callRemote(responseId, static_cast<std::streamsize>(stream.item->tellp()));
-        });
-        hub.registerFunction("Nui::seekg", [&hub](std::string const& responseId, int32_t id, int32_t pos, int32_t dir) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            stream.item->seekg(pos, static_cast<std::ios_base::seekdir>(dir));
-            hub.callRemote(responseId);
-        });
-        hub.registerFunction("Nui::seekp", [&hub](std::string const& responseId, int32_t id, int32_t pos, int32_t dir) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            stream.item->seekp(pos, static_cast<std::ios_base::seekdir>(dir));
-            hub.callRemote(responseId);
-        });
-        hub.registerFunction("Nui::read", [&hub](std::string const& responseId, int32_t id, int32_t size) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            std::string buffer(static_cast<std::size_t>(size), '\0');
-            stream.item->read(buffer.data(), size);
-            hub.callRemote(responseId, buffer);
-        });
-        hub.registerFunction("Nui::readAll", [&hub](std::string const& responseId, int32_t id) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            std::string buffer;
-            stream.item->seekg(0, std::ios_base::end);
-            buffer.resize(static_cast<std::size_t>(stream.item->tellg()));
-            stream.item->seekg(0, std::ios_base::beg);
-            stream.item->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
-            hub.callRemote(responseId, buffer);
-        });
-        hub.registerFunction("Nui::write", [&hub](std::string const& responseId, int32_t id, std::string const& data) {
-            auto& store = Detail::getStore(hub);
-            auto& stream = store[static_cast<Nui::SelectablesRegistry<std::fstream>::IdType>(id)];
-            stream.item->write(data.data(), static_cast<std::streamsize>(data.size()));
-            hub.callRemote(responseId);
-        });
+                else
+                {
+                    const auto bytes = data.is_string() ? base64Decode(data.get<std::string>()) : std::nullopt;
+                    if (!bytes)
+                        throw std::invalid_argument("Data to write is neither binary nor base64");
+                    stream.write(bytes->data(), static_cast<std::streamsize>(bytes->size()));
+                }
+                if (!stream)
+                {
+                    stream.clear();
+                    throw std::runtime_error("Writing to file " + std::to_string(id) + " failed");
+                }
+            },
+            policy);
     }
 }
\ No newline at end of file
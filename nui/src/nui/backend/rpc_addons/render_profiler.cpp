@@ -0,0 +1,24 @@
+#include "render_profiler.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace Nui
+{
+    void registerRenderProfiler(Nui::RpcHub const& hub, std::filesystem::path directory)
+    {
+        hub.registerFunction(
+            "Nui::saveRenderProfile",
+            [directory = std::move(directory)](std::string const& name, std::string const& trace) {
+                // Only a file name is accepted, the frontend must not choose where to write.
+                const std::filesystem::path fileName{name};
+                if (fileName.empty() || fileName != fileName.filename() || fileName == "." || fileName == "..")
+                {
+                    std::cerr << "Rejected render profile name: " << name << "\n";
+                    return;
+                }
+                std::ofstream writer{directory / fileName, std::ios::binary};
+                writer.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+            });
+    }
+}
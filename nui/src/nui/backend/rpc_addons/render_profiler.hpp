@@ -0,0 +1,10 @@
+#pragma once
+
+#include <nui/backend/rpc_hub.hpp>
+
+#include <filesystem>
+
+namespace Nui
+{
+    void registerRenderProfiler(Nui::RpcHub const& hub, std::filesystem::path directory);
+}
@@ -7,14 +7,87 @@
 #include "rpc_addons/timer.hpp"
 #include "rpc_addons/screen.hpp"
 #include "rpc_addons/environment_variables.hpp"
+#include "rpc_addons/render_profiler.hpp"
+
+#include <algorithm>
+#include <iterator>
 
 namespace Nui
 {
+    // #####################################################################################################################
+    namespace Detail
+    {
+        //---------------------------------------------------------------------------------------------------------------------
+        FutureWaiter::FutureWaiter()
+            : guard_{}
+            , wake_{}
+            , added_{}
+            , stopped_{false}
+            , thread_{}
+        {}
+        //---------------------------------------------------------------------------------------------------------------------
+        FutureWaiter::~FutureWaiter()
+        {
+            {
+                std::scoped_lock lock{guard_};
+                stopped_ = true;
+            }
+            wake_.notify_one();
+            if (thread_.joinable())
+                thread_.join();
+        }
+        //---------------------------------------------------------------------------------------------------------------------
+        void FutureWaiter::add(std::function<bool()> poll)
+        {
+            {
+                std::scoped_lock lock{guard_};
+                added_.push_back(std::move(poll));
+                if (!thread_.joinable())
+                    thread_ = std::thread{[this]() {
+                        run();
+                    }};
+            }
+            wake_.notify_one();
+        }
+        //---------------------------------------------------------------------------------------------------------------------
+        void FutureWaiter::run()
+        {
+            constexpr auto pollInterval = std::chrono::milliseconds{1};
+            std::vector<std::function<bool()>> pending;
+            while (true)
+            {
+                {
+                    std::unique_lock lock{guard_};
+                    const auto wakeUp = [this]() {
+                        return stopped_ || !added_.empty();
+                    };
+                    if (pending.empty())
+                        wake_.wait(lock, wakeUp);
+                    else
+                        wake_.wait_for(lock, pollInterval, wakeUp);
+                    if (stopped_)
+                        return;
+                    std::move(added_.begin(), added_.end(), std::back_inserter(pending));
+                    added_.clear();
+                }
+                std::erase_if(pending, [](auto const& poll) {
+                    return poll();
+                });
+            }
+        }
+    }
     // #####################################################################################################################
     RpcHub::RpcHub(Window& window)
         : window_{&window}
+        , futureWaiter_{std::make_unique<Detail::FutureWaiter>()}
     {}
     //---------------------------------------------------------------------------------------------------------------------
+    RpcHub::~RpcHub()
+    {
+        // Joins the waiter, pending completions would otherwise respond through a destroyed hub.
+        futureWaiter_.reset();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
     void RpcHub::enableFileDialogs() const
     {
         registerFunction("Nui::showOpenDialog", [this](nlohmann::json const& args) {
@@ -88,6 +161,11 @@ namespace Nui
         registerFetch(*this);
     }
     //---------------------------------------------------------------------------------------------------------------------
+    void RpcHub::enableFetch(FetchCacheOptions const& cacheOptions) const
+    {
+        registerFetch(*this, cacheOptions);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
     void RpcHub::enableScreen()
     {
         registerScreen(*this);
@@ -98,6 +176,11 @@ namespace Nui
         registerEnvironmentVariables(*this);
     }
     //---------------------------------------------------------------------------------------------------------------------
+    void RpcHub::enableRenderProfiler(std::filesystem::path directory) const
+    {
+        registerRenderProfiler(*this, std::move(directory));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
     void RpcHub::enableAll()
     {
         enableFileDialogs();
@@ -109,5 +192,15 @@ namespace Nui
         enableScreen();
         enableEnvironmentVariables();
     }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool RpcHub::enableBinaryTransport() const
+    {
+        return window_->enableBinaryRpcTransport();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RpcHub::enableBatching(RpcBatchingOptions const& options) const
+    {
+        window_->enableRpcBatching(options);
+    }
     // #####################################################################################################################
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <nui/window.hpp>
 
+#include <nui/data_structures/mpsc_queue.hpp>
 #include <nui/backend/filesystem/special_paths.hpp>
 #include <nui/backend/filesystem/file_dialog.hpp>
 #include <nui/utility/scope_exit.hpp>
@@ -7,19 +8,33 @@
 #include <nui/utility/scope_exit.hpp>
 #include <nui/screen.hpp>
 
+#include "binary_rpc_script.hpp"
+#if __linux__
+#    include "asset_cache.hpp"
+#endif
+
 #include <webview.h>
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/post.hpp>
-#include <roar/mime_type.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/high_resolution_timer.hpp>
 
 #if __linux__
 #    include <gtk/gtk.h>
 #endif
 
 #include <random>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include <string_view>
+#include <utility>
 #include <fstream>
 #include <filesystem>
 #include <iostream>
@@ -33,28 +48,214 @@
 struct HostNameMappingInfo
 {
     std::unordered_map<std::string, std::filesystem::path> hostNameToFolderMapping{};
+    /// Files compiled into the binary by their path, see Window::setVirtualHostNameToEmbeddedFiles.
+    std::unordered_map<std::string, std::unordered_map<std::string_view, Nui::Asset>> hostNameToEmbeddedFiles{};
     std::size_t hostNameMappingMax{0};
+    Nui::AssetCache assetCache{};
+};
+
+struct BinaryRpcTransport
+{
+    std::atomic<bool> enabled{false};
+    std::mutex guard{};
+    /// Length prefixed frames that wait for the next poll of the frontend.
+    std::string outgoing{};
+    /// A poll request that is finished as soon as there are frames.
+    WebKitURISchemeRequest* pendingPoll{nullptr};
+    bool flushScheduled{false};
+    std::function<void(std::string_view)> onFrames{};
+
+    ~BinaryRpcTransport()
+    {
+        if (pendingPoll)
+            g_object_unref(pendingPoll);
+    }
 };
 #endif
 
+#if __linux__
+extern "C" gboolean drainMainLoopDispatcher(gpointer userData);
+#endif
+
+/// Runs functions on the main loop. Any thread may post without taking a lock, one wakeup is pending at a time.
+struct MainLoopDispatcher
+{
+    Nui::MpscQueue<std::function<void()>> queue{};
+    std::atomic<bool> wakeupPending{false};
+#if __linux__
+    std::mutex sourceGuard{};
+    /// The pending idle source, 0 if there is none. The source points to this dispatcher.
+    guint idleSource{0};
+
+    /// Schedules drain on the glib main loop, for the caller of post that got true.
+    void wakeUp()
+    {
+        std::scoped_lock lock{sourceGuard};
+        idleSource = g_idle_add(&drainMainLoopDispatcher, this);
+    }
+
+    /// Called by the idle source, which removes itself afterwards.
+    void drainFromIdle()
+    {
+        {
+            std::scoped_lock lock{sourceGuard};
+            idleSource = 0;
+        }
+        drain();
+    }
+
+    /// Removes a pending idle source, so that it cannot run after the dispatcher is gone.
+    void cancelWakeUp()
+    {
+        std::scoped_lock lock{sourceGuard};
+        if (idleSource != 0)
+            g_source_remove(idleSource);
+        idleSource = 0;
+    }
+#endif
+
+    /**
+     * @brief Queues a function, returns true if the caller has to wake the main loop up.
+     */
+    bool post(std::function<void()> function)
+    {
+        queue.push(std::move(function));
+        return !wakeupPending.exchange(true, std::memory_order_acq_rel);
+    }
+
+    /// Must run on the main loop.
+    void drain()
+    {
+        // Functions posted after this point schedule a new wakeup, the ones before are visible to the drain.
+        wakeupPending.exchange(false, std::memory_order_acq_rel);
+        queue.drain([](std::function<void()> const& function) {
+            function();
+        });
+    }
+};
+
 #if defined(_WIN32)
 constexpr static auto wakeUpMessage = WM_APP + 1;
 #endif
 
 namespace Nui
 {
+    struct BoundFunction
+    {
+        std::string name;
+        std::function<void(nlohmann::json const&)> callback;
+        RpcExecutionPolicy::Target target;
+        /// Set for RpcExecutionPolicy::Target::Strand.
+        std::optional<boost::asio::strand<boost::asio::thread_pool::executor_type>> strand;
+    };
+
+    struct RpcBatcher
+    {
+        std::atomic<bool> enabled{false};
+        std::atomic<std::chrono::milliseconds::rep> window{0};
+        std::atomic<std::size_t> maxCalls{0};
+        /// Frontend function names and JSON encoded arguments in call order.
+        MpscQueue<std::pair<std::string, std::string>> queued{};
+        std::atomic<std::size_t> queuedCount{0};
+        std::atomic<bool> flushScheduled{false};
+        std::mutex statisticsGuard{};
+        RpcBatchStatistics statistics{};
+    };
+
+    namespace
+    {
+        /// Takes all queued calls and returns a script that runs them, or an empty string if there are none.
+        std::string takeRpcBatch(RpcBatcher& batcher)
+        {
+            std::vector<std::pair<std::string, std::string>> calls;
+            batcher.flushScheduled.exchange(false, std::memory_order_acq_rel);
+            batcher.queued.drain([&calls](std::pair<std::string, std::string>&& call) {
+                calls.push_back(std::move(call));
+            });
+            if (calls.empty())
+                return {};
+            batcher.queuedCount.fetch_sub(calls.size(), std::memory_order_relaxed);
+            {
+                std::scoped_lock lock{batcher.statisticsGuard};
+                auto& statistics = batcher.statistics;
+                ++statistics.batches;
+                statistics.calls += calls.size();
+                statistics.lastBatchSize = calls.size();
+                statistics.largestBatchSize = std::max(statistics.largestBatchSize, calls.size());
+                const auto bucket = std::min<std::size_t>(
+                    static_cast<std::size_t>(std::bit_width(calls.size())) - 1,
+                    statistics.batchSizeHistogram.size() - 1);
+                ++statistics.batchSizeHistogram[bucket];
+            }
+
+            // A failing call must not keep the following ones from running, like with separate evaluations.
+            std::string script = R"((function(calls) {
+                const frontend = globalThis.nui_rpc.frontend;
+                for (const call of calls) {
+                    try {
+                        frontend[call[0]](call[1]);
+                    } catch (error) {
+                        console.error("nui-rpc: frontend call failed", error);
+                    }
+                }
+            })([)";
+            bool first = true;
+            for (auto const& [name, args] : calls)
+            {
+                if (!first)
+                    script.push_back(',');
+                first = false;
+                script.push_back('[');
+                script.append(nlohmann::json(name).dump());
+                if (!args.empty())
+                {
+                    script.push_back(',');
+                    script.append(args);
+                }
+                script.push_back(']');
+            }
+            script.append("]);");
+            return script;
+        }
+
+#if defined(_WIN32)
+        std::string randomFileName()
+        {
+            constexpr static auto fileNameSize = 25;
+            std::string_view alphanum =
+                "0123456789"
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz";
+            std::random_device rd;
+            std::mt19937 gen(rd());
+            std::uniform_int_distribution<std::size_t> dis(0, alphanum.size() - 1);
+            std::string fileName(fileNameSize, '\0');
+            for (std::size_t i = 0; i < fileNameSize; ++i)
+                fileName[i] = alphanum[dis(gen)];
+            return fileName;
+        }
+#endif
+    }
+
     // #####################################################################################################################
     struct Window::Implementation
     {
         webview::webview view;
         std::vector<std::filesystem::path> cleanupFiles;
-        std::vector<std::function<void(nlohmann::json const&)>> callbacks;
+        std::vector<std::shared_ptr<BoundFunction const>> callbacks;
+        std::unordered_map<std::string, boost::asio::strand<boost::asio::thread_pool::executor_type>> strands;
+        std::mutex callbacksGuard;
         boost::asio::thread_pool pool;
+        /// Parses calls from the frontend in order, a separate thread so that busy pool threads do not hold them up.
+        boost::asio::thread_pool inbound;
         std::recursive_mutex viewGuard;
+        MainLoopDispatcher mainLoopDispatcher;
+        RpcBatcher rpcBatcher;
         int width;
         int height;
 #if __linux__
         HostNameMappingInfo hostNameMappingInfo;
+        BinaryRpcTransport binaryRpc;
 #elif defined(_WIN32)
         DWORD windowThreadId;
         std::vector<std::function<void()>> toProcessOnWindowThread;
@@ -64,10 +265,16 @@ namespace Nui
             : view{debug}
             , cleanupFiles{}
             , callbacks{}
+            , strands{}
+            , callbacksGuard{}
             , pool{4}
+            , inbound{1}
             , viewGuard{}
+            , mainLoopDispatcher{}
+            , rpcBatcher{}
 #if __linux__
             , hostNameMappingInfo{}
+            , binaryRpc{}
 #elif defined(_WIN32)
             , windowThreadId{GetCurrentThreadId()}
             , toProcessOnWindowThread{}
@@ -75,8 +282,109 @@ namespace Nui
         {}
         ~Implementation()
         {
+            inbound.stop();
+            inbound.join();
             pool.stop();
             pool.join();
+#if __linux__
+            // Nothing posts anymore, a pending drain would reference this object after it is gone.
+            mainLoopDispatcher.cancelWakeUp();
+#endif
+            // Bound functions may own objects that use the pool, these must go while it still exists.
+            callbacks.clear();
+            strands.clear();
+        }
+
+        std::size_t addBoundFunction(
+            std::string const& name,
+            std::function<void(nlohmann::json const&)> const& callback,
+            RpcExecutionPolicy const& policy)
+        {
+            auto function = std::make_shared<BoundFunction>(BoundFunction{
+                .name = name,
+                .callback = callback,
+                .target = policy.target,
+                .strand = std::nullopt,
+            });
+
+            std::scoped_lock lock{callbacksGuard};
+            if (policy.target == RpcExecutionPolicy::Target::Strand)
+            {
+                auto iter = strands.find(policy.strand);
+                if (iter == strands.end())
+                    iter = strands.emplace(policy.strand, boost::asio::make_strand(pool)).first;
+                function->strand = iter->second;
+            }
+            callbacks.push_back(std::move(function));
+            return callbacks.size() - 1;
+        }
+
+        /**
+         * @brief Runs a call from the frontend where the bound function wants it. Called on the inbound thread.
+         */
+        void dispatchRpc(std::size_t id, nlohmann::json args)
+        {
+            std::shared_ptr<BoundFunction const> function;
+            {
+                std::scoped_lock lock{callbacksGuard};
+                if (id >= callbacks.size())
+                    return;
+                function = callbacks[id];
+            }
+
+            auto run = [function, args = std::move(args)]() {
+                try
+                {
+                    function->callback(args);
+                }
+                catch (std::exception const& exc)
+                {
+                    std::cerr << "Exception in rpc function \"" << function->name << "\": " << exc.what() << "\n";
+                }
+            };
+            switch (function->target)
+            {
+                case RpcExecutionPolicy::Target::UiThread:
+                    runOnMainLoop([this, run = std::move(run)]() {
+                        std::scoped_lock lock{viewGuard};
+                        run();
+                    });
+                    break;
+                case RpcExecutionPolicy::Target::ThreadPool:
+                    boost::asio::post(pool, std::move(run));
+                    break;
+                case RpcExecutionPolicy::Target::Strand:
+                    boost::asio::post(*function->strand, std::move(run));
+                    break;
+            }
+        }
+
+        /**
+         * @brief Runs the function on the main loop, without waiting for viewGuard or any other lock.
+         */
+        void runOnMainLoop(std::function<void()> function)
+        {
+            if (!mainLoopDispatcher.post(std::move(function)))
+                return;
+#if __linux__
+            mainLoopDispatcher.wakeUp();
+#elif defined(_WIN32)
+            PostThreadMessage(windowThreadId, wakeUpMessage, 0, 0);
+#else
+            view.dispatch([this]() {
+                mainLoopDispatcher.drain();
+            });
+#endif
+        }
+
+        /// Must run on the main loop.
+        void flushRpcBatch()
+        {
+            const auto script = takeRpcBatch(rpcBatcher);
+            if (script.empty())
+                return;
+            std::scoped_lock lock{viewGuard};
+            view.eval(script);
         }
     };
     // #####################################################################################################################
@@ -91,8 +399,98 @@ std::size_t strlenLimited(char const* str, std::size_t limit)
     return i;
 }
 
+namespace
+{
+    void finishBinaryRpcRequest(WebKitURISchemeRequest* request, std::string const& body)
+    {
+        auto* bytes = g_bytes_new(body.data(), body.size());
+        GInputStream* stream = g_memory_input_stream_new_from_bytes(bytes);
+        g_bytes_unref(bytes);
+        auto freeStream = Nui::ScopeExit{[stream] {
+            g_object_unref(stream);
+        }};
+#    if WEBKIT_CHECK_VERSION(2, 36, 0)
+        auto* response = webkit_uri_scheme_response_new(stream, static_cast<gint64>(body.size()));
+        auto freeResponse = Nui::ScopeExit{[response] {
+            g_object_unref(response);
+        }};
+        webkit_uri_scheme_response_set_content_type(response, "application/octet-stream");
+        auto* headers = soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+        soup_message_headers_append(headers, "Access-Control-Allow-Origin", "*");
+        webkit_uri_scheme_response_set_http_headers(response, headers);
+        webkit_uri_scheme_request_finish_with_response(request, response);
+#    else
+        webkit_uri_scheme_request_finish(
+            request, stream, static_cast<gint64>(body.size()), "application/octet-stream");
+#    endif
+    }
+
+    /// Answers an assets:// request with the mapped asset, or the requested range of it.
+    void finishAssetRequest(WebKitURISchemeRequest* request, Nui::Asset const& asset, std::string_view rangeHeader)
+    {
+        const auto size = static_cast<std::uint64_t>(g_bytes_get_size(asset.bytes.get()));
+        const auto range = Nui::parseByteRange(rangeHeader, size);
+
+        // Slices of the mapping share it, nothing is copied.
+        GBytes* body = nullptr;
+        if (!range)
+            body = g_bytes_ref(asset.bytes.get());
+        else
+            body = g_bytes_new_from_bytes(
+                asset.bytes.get(), static_cast<gsize>(range->offset), static_cast<gsize>(range->length));
+        const auto bodySize = static_cast<gint64>(g_bytes_get_size(body));
+        GInputStream* stream = g_memory_input_stream_new_from_bytes(body);
+        g_bytes_unref(body);
+        auto freeStream = Nui::ScopeExit{[stream] {
+            g_object_unref(stream);
+        }};
+
+#    if WEBKIT_CHECK_VERSION(2, 36, 0)
+        auto* response = webkit_uri_scheme_response_new(stream, bodySize);
+        auto freeResponse = Nui::ScopeExit{[response] {
+            g_object_unref(response);
+        }};
+        webkit_uri_scheme_response_set_content_type(response, asset.mimeType.c_str());
+        auto* headers = soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+        soup_message_headers_append(headers, "Accept-Ranges", "bytes");
+        if (range && range->satisfiable)
+        {
+            webkit_uri_scheme_response_set_status(response, 206, nullptr);
+            const auto contentRange =
+                fmt::format("bytes {}-{}/{}", range->offset, range->offset + range->length - 1, size);
+            soup_message_headers_append(headers, "Content-Range", contentRange.c_str());
+        }
+        else if (range)
+        {
+            webkit_uri_scheme_response_set_status(response, 416, nullptr);
+            soup_message_headers_append(headers, "Content-Range", fmt::format("bytes */{}", size).c_str());
+        }
+        webkit_uri_scheme_response_set_http_headers(response, headers);
+        webkit_uri_scheme_request_finish_with_response(request, response);
+#    else
+        webkit_uri_scheme_request_finish(request, stream, bodySize, asset.mimeType.c_str());
+#    endif
+    }
+
+    /// Answers the pending poll with all queued frames. Must run on the main loop.
+    void flushBinaryRpc(BinaryRpcTransport& transport)
+    {
+        WebKitURISchemeRequest* request = nullptr;
+        std::string body;
+        {
+            std::scoped_lock lock{transport.guard};
+            transport.flushScheduled = false;
+            if (!transport.pendingPoll || transport.outgoing.empty())
+                return;
+            request = std::exchange(transport.pendingPoll, nullptr);
+            body.swap(transport.outgoing);
+        }
+        finishBinaryRpcRequest(request, body);
+        g_object_unref(request);
+    }
+}
+
 extern "C" {
-    // TODO: This function can be improved.
     void uriSchemeRequestCallback(WebKitURISchemeRequest* request, gpointer userData)
     {
         auto* hostNameMappingInfo = static_cast<HostNameMappingInfo*>(userData);
@@ -112,6 +510,30 @@ extern "C" {
         }};
 
         auto hostName = std::string{uri.data() + scheme.size() + 3, uri.size() - scheme.size() - 3 - path.size()};
+
+        std::string_view rangeHeader{};
+#    if WEBKIT_CHECK_VERSION(2, 36, 0)
+        if (auto* requestHeaders = webkit_uri_scheme_request_get_http_headers(request); requestHeaders)
+        {
+            if (char const* range = soup_message_headers_get_one(requestHeaders, "Range"); range)
+                rangeHeader = range;
+        }
+#    endif
+
+        if (auto embedded = hostNameMappingInfo->hostNameToEmbeddedFiles.find(hostName);
+            embedded != hostNameMappingInfo->hostNameToEmbeddedFiles.end())
+        {
+            auto file = embedded->second.find(path);
+            if (file == embedded->second.end())
+            {
+                std::cerr << "Embedded file not found: " << path << "\n";
+                return;
+            }
+            exitError.disarm();
+            finishAssetRequest(request, file->second, rangeHeader);
+            return;
+        }
+
         auto it = hostNameMappingInfo->hostNameToFolderMapping.find(hostName);
         if (it == hostNameMappingInfo->hostNameToFolderMapping.end())
         {
@@ -120,33 +542,84 @@ extern "C" {
         }
 
         const auto filePath = it->second / std::string{path.data() + 1, path.size() - 1};
-        auto fileContent = std::string{};
+
+        const auto asset = hostNameMappingInfo->assetCache.load(filePath);
+        if (!asset)
         {
-            auto file = std::ifstream{filePath, std::ios::binary};
-            if (!file)
+            std::cerr << "File not found: " << filePath << "\n";
+            return;
+        }
+
+        exitError.disarm();
+        finishAssetRequest(request, *asset, rangeHeader);
+    }
+
+    void binaryRpcRequestCallback(WebKitURISchemeRequest* request, gpointer userData)
+    {
+        auto* transport = static_cast<BinaryRpcTransport*>(userData);
+        const auto path = std::string_view{webkit_uri_scheme_request_get_path(request)};
+
+        if (path == "/poll")
+        {
+            std::string body;
+            WebKitURISchemeRequest* abandoned = nullptr;
             {
-                std::cerr << "File not found: " << filePath << "\n";
-                return;
+                std::scoped_lock lock{transport->guard};
+                if (transport->outgoing.empty())
+                {
+                    // Only one poll is kept open, a new one replaces the old, for instance after a reload.
+                    abandoned = std::exchange(
+                        transport->pendingPoll, WEBKIT_URI_SCHEME_REQUEST(g_object_ref(G_OBJECT(request))));
+                }
+                else
+                    body.swap(transport->outgoing);
+            }
+            if (abandoned)
+            {
+                finishBinaryRpcRequest(abandoned, {});
+                g_object_unref(abandoned);
             }
-            file.seekg(0, std::ios::end);
-            fileContent.resize(static_cast<std::size_t>(file.tellg()));
-            file.seekg(0, std::ios::beg);
-            file.read(fileContent.data(), static_cast<std::streamsize>(fileContent.size()));
+            if (!body.empty())
+                finishBinaryRpcRequest(request, body);
+            return;
         }
 
-        exitError.disarm();
-        GInputStream* stream =
-            g_memory_input_stream_new_from_data(fileContent.c_str(), static_cast<gssize>(fileContent.size()), nullptr);
-        auto freeStream = Nui::ScopeExit{[stream] {
-            g_object_unref(stream);
+#    if WEBKIT_CHECK_VERSION(2, 40, 0)
+        if (path == "/call")
+        {
+            std::string body;
+            if (GInputStream* stream = webkit_uri_scheme_request_get_http_body(request); stream)
+            {
+                auto freeStream = Nui::ScopeExit{[stream] {
+                    g_object_unref(stream);
+                }};
+                char buffer[16384];
+                gssize amount = 0;
+                while ((amount = g_input_stream_read(stream, buffer, sizeof(buffer), nullptr, nullptr)) > 0)
+                    body.append(buffer, static_cast<std::size_t>(amount));
+            }
+            finishBinaryRpcRequest(request, {});
+            if (transport->onFrames)
+                transport->onFrames(body);
+            return;
+        }
+#    endif
+
+        auto* error = g_error_new(WEBKIT_DOWNLOAD_ERROR_DESTINATION, 1, "Unknown nui-rpc endpoint.");
+        auto freeError = Nui::ScopeExit{[error] {
+            g_error_free(error);
         }};
-        const auto maybeMime = Roar::extensionToMime(filePath.extension().string());
-        std::string mime = maybeMime ? *maybeMime : "application/octet-stream";
-        webkit_uri_scheme_request_finish(request, stream, static_cast<gint64>(fileContent.size()), mime.c_str());
+        webkit_uri_scheme_request_finish_error(request, error);
     }
 
     void uriSchemeDestroyNotify(void*)
     {}
+
+    gboolean drainMainLoopDispatcher(gpointer userData)
+    {
+        static_cast<MainLoopDispatcher*>(userData)->drainFromIdle();
+        return G_SOURCE_REMOVE;
+    }
 }
 #endif
 
@@ -167,9 +640,18 @@ namespace Nui
         : impl_{std::make_unique<Implementation>(debug)}
     {
         impl_->view.install_message_hook([this](std::string const& msg) {
-            std::scoped_lock lock{impl_->viewGuard};
-            const auto obj = nlohmann::json::parse(msg);
-            impl_->callbacks[obj["id"].get<std::size_t>()](obj["args"]);
+            // The main loop only hands the message over, parsing and the call happen elsewhere.
+            boost::asio::post(impl_->inbound, [this, msg]() {
+                try
+                {
+                    auto obj = nlohmann::json::parse(msg);
+                    impl_->dispatchRpc(obj["id"].get<std::size_t>(), std::move(obj["args"]));
+                }
+                catch (std::exception const& exc)
+                {
+                    std::cerr << "Invalid rpc message: " << exc.what() << "\n";
+                }
+            });
             return false;
         });
         // TODO: SetCustomSchemeRegistrations
@@ -190,7 +672,7 @@ namespace Nui
     Window::~Window()
     {
         for (auto const& file : impl_->cleanupFiles)
-            std::filesystem::remove(file);
+            std::filesystem::remove_all(file);
     }
     //---------------------------------------------------------------------------------------------------------------------
     Window::Window(Window&&) = default;
@@ -219,18 +701,7 @@ namespace Nui
         // :((((
 
         using namespace std::string_literals;
-        constexpr static auto fileNameSize = 25;
-        std::string_view alphanum =
-            "0123456789"
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-            "abcdefghijklmnopqrstuvwxyz";
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<std::size_t> dis(0, alphanum.size() - 1);
-        std::string fileName(fileNameSize, '\0');
-        for (std::size_t i = 0; i < fileNameSize; ++i)
-            fileName[i] = alphanum[dis(gen)];
-        const auto tempFile = resolvePath("%temp%/"s + fileName + ".html");
+        const auto tempFile = resolvePath("%temp%/"s + randomFileName() + ".html");
         {
             std::ofstream temporary{tempFile, std::ios_base::binary};
             temporary.write(html.data(), static_cast<std::streamsize>(html.size()));
@@ -265,6 +736,7 @@ namespace Nui
                     impl_->toProcessOnWindowThread.clear();
                 }
             }
+            impl_->mainLoopDispatcher.drain();
             if (msg.message == wakeUpMessage)
                 continue;
             if (msg.hwnd)
@@ -315,11 +787,14 @@ namespace Nui
             primaryDisplay.y() + (primaryDisplay.height() - impl_->height) / 2);
     }
     //---------------------------------------------------------------------------------------------------------------------
-    void Window::bind(std::string const& name, std::function<void(nlohmann::json const&)> const& callback)
+    void Window::bind(
+        std::string const& name,
+        std::function<void(nlohmann::json const&)> const& callback,
+        RpcExecutionPolicy const& policy)
     {
-        auto bindImpl = [this, name, callback]() {
+        auto bindImpl = [this, name, callback, policy]() {
             std::scoped_lock lock{impl_->viewGuard};
-            impl_->callbacks.push_back(callback);
+            const auto id = impl_->addBoundFunction(name, callback, policy);
             auto script = fmt::format(
                 R"(
                     (() => {{
@@ -329,6 +804,8 @@ namespace Nui
                             frontend: {{}}, backend: {{}}, tempId: 0
                         }});
                         globalThis.nui_rpc.backend[name] = (...args) => {{
+                            if (globalThis.nui_rpc.sendBinary)
+                                return globalThis.nui_rpc.sendBinary(id, [...args]);
                             globalThis.external.invoke(JSON.stringify({{
                                 name: name,
                                 id: id,
@@ -338,7 +815,7 @@ namespace Nui
                     }})();
                 )",
                 name,
-                impl_->callbacks.size() - 1);
+                id);
 
             impl_->view.init(script);
             impl_->view.eval(script);
@@ -360,22 +837,152 @@ namespace Nui
     //---------------------------------------------------------------------------------------------------------------------
     void Window::eval(std::string const& js)
     {
-        std::scoped_lock lock{impl_->viewGuard};
-#if defined(_WIN32)
-        if (GetCurrentThreadId() == impl_->windowThreadId)
+        // Callers, like rpc from the thread pool, only queue the script and never wait for viewGuard.
+        impl_->runOnMainLoop([this, js]() {
+            std::scoped_lock lock{impl_->viewGuard};
             impl_->view.eval(js);
-        else
+        });
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool Window::enableBinaryRpcTransport()
+    {
+        std::scoped_lock lock{impl_->viewGuard};
+#if __linux__
+        if (impl_->binaryRpc.enabled)
+            return true;
+
+        impl_->binaryRpc.onFrames = [this](std::string_view view) {
+            boost::asio::post(impl_->inbound, [this, frames = std::string{view}]() {
+                std::size_t offset = 0;
+                while (offset + 4 <= frames.size())
+                {
+                    const auto* prefix = reinterpret_cast<unsigned char const*>(frames.data() + offset);
+                    const std::size_t length = (static_cast<std::size_t>(prefix[0]) << 24) |
+                        (static_cast<std::size_t>(prefix[1]) << 16) | (static_cast<std::size_t>(prefix[2]) << 8) |
+                        static_cast<std::size_t>(prefix[3]);
+                    offset += 4;
+                    if (offset + length > frames.size())
+                        break;
+
+                    auto call = nlohmann::json::from_msgpack(
+                        frames.begin() + static_cast<std::ptrdiff_t>(offset),
+                        frames.begin() + static_cast<std::ptrdiff_t>(offset + length),
+                        true,
+                        false);
+                    offset += length;
+                    if (call.is_discarded() || !call.is_array() || call.size() != 2 || !call[0].is_number_unsigned())
+                        continue;
+                    impl_->dispatchRpc(call[0].get<std::size_t>(), std::move(call[1]));
+                }
+            });
+        };
+
+        auto nativeWebView = WEBKIT_WEB_VIEW(getNativeWebView());
+        auto* webContext = webkit_web_view_get_context(nativeWebView);
+        webkit_web_context_register_uri_scheme(
+            webContext, "nui-rpc", &binaryRpcRequestCallback, &impl_->binaryRpc, &uriSchemeDestroyNotify);
+        webkit_security_manager_register_uri_scheme_as_cors_enabled(
+            webkit_web_context_get_security_manager(webContext), "nui-rpc");
+
+#    if WEBKIT_CHECK_VERSION(2, 40, 0)
+        constexpr static auto canPost = "true";
+#    else
+        constexpr static auto canPost = "false";
+#    endif
+        const auto script = fmt::format("({})({});", Detail::binaryRpcScript, canPost);
+        impl_->view.init(script);
+        impl_->view.eval(script);
+        impl_->binaryRpc.enabled = true;
+        return true;
+#else
+        return false;
+#endif
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool Window::binaryRpcTransportEnabled() const
+    {
+#if __linux__
+        return impl_->binaryRpc.enabled;
+#else
+        return false;
+#endif
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void Window::sendBinaryRpcFrame(std::vector<std::uint8_t> const& frame)
+    {
+#if __linux__
+        bool schedule = false;
+        {
+            std::scoped_lock lock{impl_->binaryRpc.guard};
+            const auto length = static_cast<std::uint32_t>(frame.size());
+            impl_->binaryRpc.outgoing.push_back(static_cast<char>((length >> 24) & 0xff));
+            impl_->binaryRpc.outgoing.push_back(static_cast<char>((length >> 16) & 0xff));
+            impl_->binaryRpc.outgoing.push_back(static_cast<char>((length >> 8) & 0xff));
+            impl_->binaryRpc.outgoing.push_back(static_cast<char>(length & 0xff));
+            impl_->binaryRpc.outgoing.append(reinterpret_cast<char const*>(frame.data()), frame.size());
+            schedule = impl_->binaryRpc.pendingPoll != nullptr && !impl_->binaryRpc.flushScheduled;
+            impl_->binaryRpc.flushScheduled = impl_->binaryRpc.flushScheduled || schedule;
+        }
+        // Requests must be finished on the main loop.
+        if (schedule)
         {
-            impl_->toProcessOnWindowThread.push_back([this, js]() {
-                impl_->view.eval(js);
+            impl_->runOnMainLoop([this]() {
+                flushBinaryRpc(impl_->binaryRpc);
             });
-            PostThreadMessage(impl_->windowThreadId, wakeUpMessage, 0, 0);
         }
 #else
-        impl_->view.eval(js);
+        (void)frame;
 #endif
     }
     //---------------------------------------------------------------------------------------------------------------------
+    void Window::enableRpcBatching(RpcBatchingOptions const& options)
+    {
+        impl_->rpcBatcher.window = options.window.count();
+        impl_->rpcBatcher.maxCalls = options.maxCalls;
+        impl_->rpcBatcher.enabled = true;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool Window::rpcBatchingEnabled() const
+    {
+        return impl_->rpcBatcher.enabled;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void Window::queueRpcCall(std::string const& name, std::string args)
+    {
+        auto& batcher = impl_->rpcBatcher;
+        batcher.queued.push({name, std::move(args)});
+        const auto count = batcher.queuedCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        const bool schedule = !batcher.flushScheduled.exchange(true, std::memory_order_acq_rel);
+        const auto maxCalls = batcher.maxCalls.load(std::memory_order_relaxed);
+        const bool full = maxCalls != 0 && count % maxCalls == 0;
+        const auto window = std::chrono::milliseconds{batcher.window.load(std::memory_order_relaxed)};
+
+        // The main loop runs the flush when it is idle.
+        if (full || (schedule && window.count() == 0))
+        {
+            impl_->runOnMainLoop([this]() {
+                impl_->flushRpcBatch();
+            });
+        }
+        else if (schedule)
+        {
+            auto timer = std::make_shared<boost::asio::high_resolution_timer>(impl_->pool, window);
+            timer->async_wait([this, timer](boost::system::error_code const& ec) {
+                if (ec)
+                    return;
+                impl_->runOnMainLoop([this]() {
+                    impl_->flushRpcBatch();
+                });
+            });
+        }
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    RpcBatchStatistics Window::rpcBatchStatistics() const
+    {
+        std::scoped_lock lock{impl_->rpcBatcher.statisticsGuard};
+        return impl_->rpcBatcher.statistics;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
     void* Window::getNativeWebView()
     {
         return static_cast<webview::browser_engine&>(impl_->view).webview();
@@ -437,6 +1044,43 @@ namespace Nui
         impl_->hostNameMappingInfo.hostNameMappingMax =
             std::max(impl_->hostNameMappingInfo.hostNameMappingMax, hostName.size());
         impl_->hostNameMappingInfo.hostNameToFolderMapping[hostName] = folderPath;
+        impl_->hostNameMappingInfo.hostNameToEmbeddedFiles.erase(hostName);
+#endif
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void Window::setVirtualHostNameToEmbeddedFiles(
+        std::string const& hostName,
+        std::span<EmbeddedFile const> files,
+        HostResourceAccessKind accessKind)
+    {
+#if defined(_WIN32)
+        // WebView2 can only map folders.
+        using namespace std::string_literals;
+        const auto folder = resolvePath("%temp%/"s + randomFileName());
+        for (auto const& file : files)
+        {
+            const auto target = folder / std::filesystem::path{file.path}.relative_path();
+            std::filesystem::create_directories(target.parent_path());
+            std::ofstream output{target, std::ios_base::binary};
+            output.write(file.content.data(), static_cast<std::streamsize>(file.content.size()));
+        }
+        {
+            std::scoped_lock lock{impl_->viewGuard};
+            impl_->cleanupFiles.push_back(folder);
+        }
+        setVirtualHostNameToFolderMapping(hostName, folder, accessKind);
+#elif defined(__APPLE__)
+        throw std::runtime_error("Not implemented");
+#else
+        (void)accessKind;
+        std::scoped_lock lock{impl_->viewGuard};
+        auto& embedded = impl_->hostNameMappingInfo.hostNameToEmbeddedFiles[hostName];
+        embedded.clear();
+        for (auto const& file : files)
+            embedded.insert_or_assign(file.path, embeddedAsset(file));
+        impl_->hostNameMappingInfo.hostNameMappingMax =
+            std::max(impl_->hostNameMappingInfo.hostNameMappingMax, hostName.size());
+        impl_->hostNameMappingInfo.hostNameToFolderMapping.erase(hostName);
 #endif
     }
     //---------------------------------------------------------------------------------------------------------------------
@@ -5,25 +5,93 @@
 #include <nui/frontend/api/console.hpp>
 
 #include <nui/frontend/val.hpp>
+#include <nui/utility/base64.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 
 namespace Nui
 {
-    void fetch(
+    namespace
+    {
+        /// Text bodies arrive as they are, binary ones as Uint8Array over the binary rpc transport and as base64
+        /// otherwise. atob cannot be used, converting its result to std::string would encode every byte as utf-8.
+        bool decodeBody(Nui::val const& response, FetchResponse& resp, bool dontDecodeBody)
+        {
+            if (response.hasOwnProperty("bodyBytes"))
+            {
+                const auto bytes = emscripten::convertJSArrayToNumberVector<std::uint8_t>(response["bodyBytes"]);
+                resp.body.assign(bytes.begin(), bytes.end());
+                return true;
+            }
+            if (dontDecodeBody || !response.hasOwnProperty("bodyIsBase64") || !response["bodyIsBase64"].as<bool>())
+                return true;
+            auto body = base64Decode(resp.body);
+            if (!body)
+                return false;
+            resp.body = std::move(*body);
+            return true;
+        }
+
+        /// Headers that are not valid utf-8 arrive as base64, names and values alike.
+        bool decodeHeaders(Nui::val const& response, FetchResponse& resp)
+        {
+            if (!response.hasOwnProperty("headersAreBase64") || !response["headersAreBase64"].as<bool>())
+                return true;
+            std::unordered_map<std::string, std::string> headers;
+            for (auto const& [name, value] : resp.headers)
+            {
+                auto decodedName = base64Decode(name);
+                auto decodedValue = base64Decode(value);
+                if (!decodedName || !decodedValue)
+                    return false;
+                headers.emplace(std::move(*decodedName), std::move(*decodedValue));
+            }
+            resp.headers = std::move(headers);
+            return true;
+        }
+    }
+
+    std::uint32_t fetch(
         std::string const& uri,
         FetchOptions const& options,
         std::function<void(std::optional<FetchResponse> const&)> callback)
     {
-        Nui::RpcClient::getRemoteCallableWithBackChannel(
-            "Nui::fetch", [callback = std::move(callback), options](Nui::val response) {
+        const auto requestId = RpcClient::registerRequest(
+            [callback, dontDecodeBody = options.dontDecodeBody](Nui::val const& response) {
                 std::optional<FetchResponse> resp;
                 Nui::convertFromVal(response, resp);
-                if (resp && !options.dontDecodeBody)
-                    resp->body = Nui::val::global("atob")(resp->body).as<std::string>();
+                if (resp && !decodeBody(response, *resp, dontDecodeBody))
+                    resp.reset();
+                if (resp && !decodeHeaders(response, *resp))
+                    resp.reset();
                 callback(resp);
-            })(uri, options);
+            },
+            [callback](std::string const&) {
+                callback(std::nullopt);
+            });
+        RpcClient::RemoteCallable{"Nui::fetch", requestId}(uri, options);
+        return requestId;
+    }
+    std::uint32_t fetch(std::string const& uri, std::function<void(std::optional<FetchResponse> const&)> callback)
+    {
+        return fetch(uri, {}, std::move(callback));
+    }
+    void cancelFetch(std::uint32_t fetchId)
+    {
+        RpcClient::cancelRequest(fetchId);
+        RpcClient::getRemoteCallable("Nui::cancelFetch")(fetchId);
     }
-    void fetch(std::string const& uri, std::function<void(std::optional<FetchResponse> const&)> callback)
+    void fetchCacheStatistics(std::function<void(std::optional<FetchCacheStatistics> const&)> callback)
     {
-        fetch(uri, {}, std::move(callback));
+        RpcClient::getRemoteCallableWithResult(
+            "Nui::fetchCacheStatistics",
+            [callback](FetchCacheStatistics const& statistics) {
+                callback(statistics);
+            },
+            [callback](std::string const&) {
+                callback(std::nullopt);
+            })();
     }
 }
\ No newline at end of file
@@ -1,25 +1,85 @@
 #include <nui/frontend/attributes/impl/attribute.hpp>
 #include <nui/frontend/dom/childless_element.hpp>
+#include <nui/frontend/event_system/event_delegation.hpp>
+#include <nui/frontend/event_system/observed_value.hpp>
+#include <nui/frontend/utility/render_profiler.hpp>
+#include <nui/utility/overloaded.hpp>
 
-#include <iostream>
+#include <string_view>
 
 namespace Nui
 {
     void Attribute::setOn(Dom::ChildlessElement& element) const
     {
-        if (setter_)
-            setter_(element);
+        RenderProfiler::countDomOperation();
+        std::visit(
+            overloaded{
+                [](std::monostate) {},
+                [&element](StaticValue const& staticValue) {
+                    std::visit(
+                        [&element, name = staticValue.name](auto const& value) {
+                            element.setAttribute(name, value);
+                        },
+                        staticValue.value);
+                },
+                [&element](ObservedBinding const& binding) {
+                    binding.setter(element, binding.name, *binding.observed);
+                },
+                [&element](CombinatorBinding const& binding) {
+                    if (binding.setter)
+                        binding.setter(element);
+                },
+                [&element](EventHandler const& eventHandler) {
+                    element.setAttribute(eventHandler.name, [handler = eventHandler.handler](Nui::val val) {
+                        handler(std::move(val));
+                        globalEventContext.executeActiveEventsImmediately();
+                    });
+                },
+                [&element](DelegatedEventHandler const& eventHandler) {
+                    if (element.prerendered())
+                        return;
+                    // "onclick" listens to "click"
+                    std::string_view eventType{eventHandler.name};
+                    if (eventType.starts_with("on"))
+                        eventType.remove_prefix(2);
+                    globalEventDelegation.addHandler(element, std::string{eventType}, eventHandler.handler);
+                },
+            },
+            representation_);
     }
 
     EventContext::EventIdType Attribute::createEvent(std::weak_ptr<Dom::ChildlessElement>&& element) const
     {
-        if (createEvent_)
-            return createEvent_(std::move(element));
+        if (auto const* binding = std::get_if<ObservedBinding>(&representation_); binding)
+            return binding->createEvent(std::move(element), binding->name, *binding->observed);
+        if (auto const* binding = std::get_if<CombinatorBinding>(&representation_); binding && binding->createEvent)
+            return binding->createEvent(std::move(element));
         return EventContext::EventIdType{};
     }
 
+    void Attribute::clearEvent(EventContext::EventIdType const& id) const
+    {
+        if (auto const* binding = std::get_if<ObservedBinding>(&representation_); binding)
+            binding->observed->unattachEvent(id);
+        else if (auto const* binding = std::get_if<CombinatorBinding>(&representation_); binding && binding->clearEvent)
+            binding->clearEvent(id);
+    }
+
     std::function<void(EventContext::EventIdType const&)> Attribute::getEventClear() const
     {
-        return clearEvent_;
+        if (!isDynamic())
+            return {};
+        return [attribute = *this](EventContext::EventIdType const& id) {
+            attribute.clearEvent(id);
+        };
+    }
+
+    bool Attribute::isDynamic() const
+    {
+        if (std::holds_alternative<ObservedBinding>(representation_))
+            return true;
+        if (auto const* binding = std::get_if<CombinatorBinding>(&representation_); binding)
+            return static_cast<bool>(binding->clearEvent);
+        return false;
     }
-}
\ No newline at end of file
+}
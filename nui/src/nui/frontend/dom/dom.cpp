@@ -1,9 +1,49 @@
 #include <nui/frontend/dom/dom.hpp>
+#include <nui/frontend/dom/hydration.hpp>
+#include <nui/frontend/dom/prerendered_node.hpp>
 
 #include <nui/frontend/val.hpp>
 
 namespace Nui::Dom
 {
+    namespace
+    {
+        thread_local bool hydrating = false;
+        thread_local bool prerendering = false;
+    }
+
+    // #####################################################################################################################
+    HydrationScope::HydrationScope()
+        : previous_{hydrating}
+    {
+        hydrating = true;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    HydrationScope::~HydrationScope()
+    {
+        hydrating = previous_;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool HydrationScope::active()
+    {
+        return hydrating;
+    }
+    // #####################################################################################################################
+    PrerenderScope::PrerenderScope()
+        : previous_{prerendering}
+    {
+        prerendering = true;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    PrerenderScope::~PrerenderScope()
+    {
+        prerendering = previous_;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool PrerenderScope::active()
+    {
+        return prerendering;
+    }
     // #####################################################################################################################
     Dom::Dom()
         : root_{std::make_shared<Element>(Nui::val::global("document")["body"])}
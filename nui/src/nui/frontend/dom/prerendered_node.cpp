@@ -0,0 +1,195 @@
+#include <nui/frontend/dom/prerendered_node.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace Nui::Dom
+{
+    namespace
+    {
+        std::string_view trim(std::string_view view)
+        {
+            while (!view.empty() && (view.front() == ' ' || view.front() == '\t' || view.front() == '\n'))
+                view.remove_prefix(1);
+            while (!view.empty() && (view.back() == ' ' || view.back() == '\t' || view.back() == '\n'))
+                view.remove_suffix(1);
+            return view;
+        }
+
+        std::string formatNumber(double value)
+        {
+            if (std::isnan(value))
+                return "NaN";
+            if (std::isinf(value))
+                return value > 0 ? "Infinity" : "-Infinity";
+            char buffer[32];
+            const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            if (error != std::errc{})
+                return {};
+            return {buffer, end};
+        }
+
+        auto findChild(std::vector<std::shared_ptr<PrerenderedNode>>& children, PrerenderedNode const* child)
+        {
+            return std::find_if(children.begin(), children.end(), [child](auto const& candidate) {
+                return candidate.get() == child;
+            });
+        }
+    }
+
+    // #####################################################################################################################
+    void PrerenderedNode::appendChild(std::shared_ptr<PrerenderedNode> child)
+    {
+        child->remove();
+        child->parent = this;
+        children.push_back(std::move(child));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::insertBefore(std::shared_ptr<PrerenderedNode> child, PrerenderedNode const* next)
+    {
+        child->remove();
+        child->parent = this;
+        children.insert(findChild(children, next), std::move(child));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::replaceWith(std::shared_ptr<PrerenderedNode> replacement)
+    {
+        if (!parent)
+            return;
+        auto* owner = parent;
+        auto iter = findChild(owner->children, this);
+        if (iter == owner->children.end())
+            return;
+        replacement->remove();
+        replacement->parent = owner;
+        parent = nullptr;
+        // Might destroy this node, nothing may be accessed afterwards.
+        *iter = std::move(replacement);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::remove()
+    {
+        if (!parent)
+            return;
+        auto* owner = parent;
+        parent = nullptr;
+        if (auto iter = findChild(owner->children, this); iter != owner->children.end())
+            owner->children.erase(iter);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::setText(std::string value)
+    {
+        for (auto const& child : children)
+            child->parent = nullptr;
+        children.clear();
+        text = std::move(value);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::setAttribute(std::string_view name, std::string value)
+    {
+        auto iter = std::find_if(attributes.begin(), attributes.end(), [name](auto const& attribute) {
+            return attribute.first == name;
+        });
+        if (iter != attributes.end())
+            iter->second = std::move(value);
+        else
+            attributes.emplace_back(std::string{name}, std::move(value));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::setAttribute(std::string_view name, double value)
+    {
+        setAttribute(name, formatNumber(value));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::removeAttribute(std::string_view name)
+    {
+        std::erase_if(attributes, [name](auto const& attribute) {
+            return attribute.first == name;
+        });
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::toggleClass(std::string_view name, bool enabled)
+    {
+        std::vector<std::string_view> classes;
+        std::string const* current = attribute("class");
+        std::string_view rest = current ? std::string_view{*current} : std::string_view{};
+        while (!rest.empty())
+        {
+            const auto space = rest.find(' ');
+            if (const auto token = trim(rest.substr(0, space)); !token.empty())
+                classes.push_back(token);
+            rest = space == std::string_view::npos ? std::string_view{} : rest.substr(space + 1);
+        }
+
+        const bool present = std::find(classes.begin(), classes.end(), name) != classes.end();
+        if (present == enabled)
+            return;
+        if (enabled)
+            classes.push_back(name);
+        else
+            std::erase(classes, name);
+
+        std::string result;
+        for (auto const& token : classes)
+        {
+            if (!result.empty())
+                result += ' ';
+            result += token;
+        }
+        setAttribute("class", std::move(result));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void PrerenderedNode::setStyleProperty(std::string_view key, std::string_view value)
+    {
+        std::vector<std::pair<std::string_view, std::string_view>> declarations;
+        std::string const* current = attribute("style");
+        std::string_view rest = current ? std::string_view{*current} : std::string_view{};
+        while (!rest.empty())
+        {
+            const auto semicolon = rest.find(';');
+            const auto declaration = rest.substr(0, semicolon);
+            rest = semicolon == std::string_view::npos ? std::string_view{} : rest.substr(semicolon + 1);
+            const auto colon = declaration.find(':');
+            if (colon == std::string_view::npos)
+                continue;
+            declarations.emplace_back(trim(declaration.substr(0, colon)), trim(declaration.substr(colon + 1)));
+        }
+
+        auto iter = std::find_if(declarations.begin(), declarations.end(), [key](auto const& declaration) {
+            return declaration.first == key;
+        });
+        if (value.empty())
+        {
+            if (iter == declarations.end())
+                return;
+            declarations.erase(iter);
+        }
+        else if (iter != declarations.end())
+            iter->second = value;
+        else
+            declarations.emplace_back(key, value);
+
+        // Formatted like the browser writes element.style back to the attribute.
+        std::string result;
+        for (auto const& [name, declarationValue] : declarations)
+        {
+            if (!result.empty())
+                result += ' ';
+            result += name;
+            result += ": ";
+            result += declarationValue;
+            result += ';';
+        }
+        setAttribute("style", std::move(result));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::string const* PrerenderedNode::attribute(std::string_view name) const
+    {
+        auto iter = std::find_if(attributes.begin(), attributes.end(), [name](auto const& attribute) {
+            return attribute.first == name;
+        });
+        return iter != attributes.end() ? &iter->second : nullptr;
+    }
+    // #####################################################################################################################
+}
@@ -0,0 +1,160 @@
+#include <nui/frontend/event_system/event_delegation.hpp>
+
+#include <nui/frontend/dom/basic_element.hpp>
+#include <nui/frontend/event_system/event_context.hpp>
+#include <nui/frontend/utility/functions.hpp>
+
+#include <algorithm>
+
+namespace Nui
+{
+    thread_local EventDelegation globalEventDelegation;
+
+    // #####################################################################################################################
+    void EventDelegation::addHandler(
+        Dom::BasicElement& element,
+        std::string eventType,
+        std::function<void(Nui::val)> handler)
+    {
+        listenTo(eventType);
+        const auto id = slotFor(element);
+        slots_[id].handlers.emplace_back(std::move(eventType), std::move(handler));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::removeHandlers(Dom::BasicElement& element)
+    {
+        if (const auto id = slotOf(element); id)
+            release(*id);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::dispatch(Nui::val event)
+    {
+        const auto type = event["type"].as<std::string>();
+        const bool bubbles = event["bubbles"].as<bool>();
+
+        bool handled = false;
+        auto node = event["target"];
+        while (!node.isNull() && !node.isUndefined())
+        {
+            if (node.hasOwnProperty(idProperty))
+            {
+                const auto id = node[idProperty].as<IdType>();
+                auto element = id < slots_.size() ? slots_[id].element.lock() : nullptr;
+                if (id < slots_.size() && !element)
+                    release(id);
+                // A released slot may have been reused by another element, the node then is not its owner anymore.
+                else if (element && element->val().strictlyEquals(node))
+                {
+                    // Handlers may render and thereby grow the table, so never hold references into it.
+                    for (std::size_t i = 0; id < slots_.size() && i < slots_[id].handlers.size(); ++i)
+                    {
+                        if (slots_[id].handlers[i].first != type)
+                            continue;
+                        auto handler = slots_[id].handlers[i].second;
+                        handler(event);
+                        handled = true;
+                    }
+                }
+            }
+            if (!bubbles || event["cancelBubble"].as<bool>())
+                break;
+            node = node["parentNode"];
+        }
+        if (handled)
+            globalEventContext.executeActiveEventsImmediately();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::reset()
+    {
+        slots_.clear();
+        freeSlots_.clear();
+        listenedTypes_.clear();
+        sweepThreshold_ = 64;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::optional<EventDelegation::IdType> EventDelegation::slotOf(Dom::BasicElement& element) const
+    {
+        auto& node = element.val();
+        if (!node.hasOwnProperty(idProperty))
+            return std::nullopt;
+        const auto id = node[idProperty].as<IdType>();
+        if (id < slots_.size() && slots_[id].element.lock().get() == &element)
+            return id;
+        return std::nullopt;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    EventDelegation::IdType EventDelegation::slotFor(Dom::BasicElement& element)
+    {
+        if (const auto id = slotOf(element); id)
+            return *id;
+
+        auto& node = element.val();
+
+        if (freeSlots_.empty() && slots_.size() >= sweepThreshold_)
+            sweep();
+
+        IdType id;
+        if (!freeSlots_.empty())
+        {
+            id = freeSlots_.back();
+            freeSlots_.pop_back();
+        }
+        else
+        {
+            id = slots_.size();
+            slots_.emplace_back();
+        }
+        slots_[id].element = element.weak_from_base<Dom::BasicElement>();
+        node.set(idProperty, Nui::val{id});
+        return id;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool EventDelegation::isStale(IdType id) const
+    {
+        auto element = slots_[id].element.lock();
+        if (!element)
+            return true;
+
+        // The element may have been replaced in place and now carries a different node.
+        auto& node = element->val();
+        return !node.hasOwnProperty(idProperty) || node[idProperty].as<IdType>() != id;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::release(IdType id)
+    {
+        if (slots_[id].handlers.empty())
+            return;
+        slots_[id].element.reset();
+        slots_[id].handlers.clear();
+        freeSlots_.push_back(id);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::sweep()
+    {
+        for (IdType id = 0; id != slots_.size(); ++id)
+        {
+            // Free slots have no handlers.
+            if (!slots_[id].handlers.empty() && isStale(id))
+                release(id);
+        }
+        sweepThreshold_ = std::max<std::size_t>(64, elementCount() * 2);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void EventDelegation::listenTo(std::string const& eventType)
+    {
+        if (!listenedTypes_.insert(eventType).second)
+            return;
+
+        Nui::val::global("document")
+            .call<void>(
+                "addEventListener",
+                Nui::val{eventType},
+                Nui::bind(
+                    [this](Nui::val event) {
+                        dispatch(std::move(event));
+                    },
+                    std::placeholders::_1),
+                Nui::val{true});
+    }
+    // #####################################################################################################################
+}
@@ -2,16 +2,59 @@
 
 #include <nui/frontend/rpc_client.hpp>
 #include <nui/frontend/utility/val_conversion.hpp>
+#include <nui/frontend/val.hpp>
+#include <nui/utility/base64.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <string_view>
+#include <utility>
 
 namespace Nui
 {
+    namespace
+    {
+        /// Chunks arrive as Uint8Array over the binary rpc transport and as base64 otherwise.
+        std::optional<std::string> decodeChunk(Nui::val const& data)
+        {
+            if (data.typeOf().as<std::string>() == "string")
+                return base64Decode(data.as<std::string>());
+            const auto bytes = emscripten::convertJSArrayToNumberVector<std::uint8_t>(data);
+            return std::string{bytes.begin(), bytes.end()};
+        }
+
+        /// A Uint8Array over the binary rpc transport, base64 when the call is stringified.
+        Nui::val encodeData(std::string_view data)
+        {
+            if (!Nui::val::global("nui_rpc").hasOwnProperty("sendBinary"))
+                return Nui::val{base64Encode(data)};
+            // A view into the wasm memory is enough, the transport encodes the call before it returns.
+            return Nui::val{
+                emscripten::typed_memory_view(data.size(), reinterpret_cast<std::uint8_t const*>(data.data()))};
+        }
+    }
+
     // #####################################################################################################################
     AsyncFile::AsyncFile(int32_t id)
         : fileId_{id}
     {}
     //---------------------------------------------------------------------------------------------------------------------
+    AsyncFile::AsyncFile(AsyncFile&& other) noexcept
+        : fileId_{std::exchange(other.fileId_, -1)}
+    {}
+    //---------------------------------------------------------------------------------------------------------------------
+    AsyncFile& AsyncFile::operator=(AsyncFile&& other)
+    {
+        if (this != &other)
+        {
+            if (fileId_ != -1)
+                RpcClient::getRemoteCallable("Nui::closeFile")(fileId_);
+            fileId_ = std::exchange(other.fileId_, -1);
+        }
+        return *this;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
     AsyncFile::~AsyncFile()
     {
         if (fileId_ != -1)
@@ -20,41 +63,218 @@ namespace Nui
         }
     }
     //---------------------------------------------------------------------------------------------------------------------
-    void AsyncFile::tellg(std::function<void(int32_t)> cb) const
+    void AsyncFile::tellg(std::function<void(std::int64_t)> cb) const
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::tellg", std::move(cb))(fileId_);
+        // 64 bit integers cannot be converted from javascript numbers, doubles hold positions up to 2^53 exactly.
+        RpcClient::getRemoteCallableWithResult("Nui::tellg", [cb = std::move(cb)](double position) {
+            cb(static_cast<std::int64_t>(position));
+        })(fileId_);
     }
     //---------------------------------------------------------------------------------------------------------------------
-    void AsyncFile::tellp(std::function<void(int32_t)> cb) const
+    void AsyncFile::tellp(std::function<void(std::int64_t)> cb) const
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::tellp", std::move(cb))(fileId_);
+        RpcClient::getRemoteCallableWithResult("Nui::tellp", [cb = std::move(cb)](double position) {
+            cb(static_cast<std::int64_t>(position));
+        })(fileId_);
     }
     //---------------------------------------------------------------------------------------------------------------------
-    void AsyncFile::seekg(int32_t pos, std::function<void()> cb, std::ios_base::seekdir dir)
+    void AsyncFile::seekg(std::int64_t pos, std::function<void()> cb, std::ios_base::seekdir dir)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::seekg", std::move(cb))(
-            fileId_, pos, static_cast<int32_t>(dir));
+        RpcClient::getRemoteCallableWithResult("Nui::seekg", std::move(cb))(
+            fileId_, static_cast<double>(pos), static_cast<int32_t>(dir));
     }
     //---------------------------------------------------------------------------------------------------------------------
-    void AsyncFile::seekp(int32_t pos, std::function<void()> cb, std::ios_base::seekdir dir)
+    void AsyncFile::seekp(std::int64_t pos, std::function<void()> cb, std::ios_base::seekdir dir)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::seekp", std::move(cb))(
-            fileId_, pos, static_cast<int32_t>(dir));
+        RpcClient::getRemoteCallableWithResult("Nui::seekp", std::move(cb))(
+            fileId_, static_cast<double>(pos), static_cast<int32_t>(dir));
     }
     //---------------------------------------------------------------------------------------------------------------------
     void AsyncFile::read(int32_t size, std::function<void(std::string&&)> cb)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::read", std::move(cb))(fileId_, size);
+        chunks(static_cast<std::uint32_t>(size)).next([cb = std::move(cb)](std::optional<std::string>&& chunk) {
+            cb(std::move(chunk).value_or(std::string{}));
+        });
     }
     //---------------------------------------------------------------------------------------------------------------------
     void AsyncFile::readAll(std::function<void(std::string&&)> cb)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::readAll", std::move(cb))(fileId_);
+        seekg(0, [fileId = fileId_, cb = std::move(cb)]() {
+            auto content = std::make_shared<std::string>();
+            AsyncFileChunks{fileId, defaultChunkSize}.forEach(
+                [content](std::string&& chunk) {
+                    content->append(chunk);
+                },
+                [content, cb]() {
+                    cb(std::move(*content));
+                });
+        });
     }
     //---------------------------------------------------------------------------------------------------------------------
     void AsyncFile::write(std::string const& data, std::function<void()> cb)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::write", std::move(cb))(fileId_, data);
+        RpcClient::getRemoteCallableWithResult("Nui::write", std::move(cb))(fileId_, encodeData(data));
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    AsyncFileChunks AsyncFile::chunks(std::uint32_t chunkSize) const
+    {
+        return AsyncFileChunks{fileId_, chunkSize};
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    AsyncFileWriter AsyncFile::writer(std::uint32_t chunkSize) const
+    {
+        return AsyncFileWriter{fileId_, chunkSize};
+    }
+    // #####################################################################################################################
+    AsyncFileChunks::AsyncFileChunks(int32_t fileId, std::uint32_t chunkSize)
+        : fileId_{fileId}
+        , chunkSize_{chunkSize}
+        , done_{std::make_shared<bool>(false)}
+    {}
+    //---------------------------------------------------------------------------------------------------------------------
+    void AsyncFileChunks::next(std::function<void(std::optional<std::string>&&)> onChunk)
+    {
+        if (*done_)
+        {
+            onChunk(std::nullopt);
+            return;
+        }
+
+        RpcClient::getRemoteCallableWithResult(
+            "Nui::readChunk",
+            [done = done_, onChunk](Nui::val response) {
+                auto chunk = decodeChunk(response["data"]);
+                if (!chunk || *done)
+                {
+                    *done = true;
+                    onChunk(std::nullopt);
+                    return;
+                }
+                *done = response["end"].as<bool>();
+                if (chunk->empty() && *done)
+                    onChunk(std::nullopt);
+                else
+                    onChunk(std::move(chunk));
+            },
+            [done = done_, onChunk](std::string const&) {
+                *done = true;
+                onChunk(std::nullopt);
+            })(fileId_, chunkSize_);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void AsyncFileChunks::forEach(std::function<void(std::string&&)> onChunk, std::function<void()> onEnd)
+    {
+        next([self = *this, onChunk = std::move(onChunk), onEnd = std::move(onEnd)](
+                 std::optional<std::string>&& chunk) mutable {
+            if (!chunk)
+            {
+                if (onEnd)
+                    onEnd();
+                return;
+            }
+            onChunk(std::move(*chunk));
+            self.forEach(std::move(onChunk), std::move(onEnd));
+        });
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool AsyncFileChunks::done() const
+    {
+        return *done_;
+    }
+    // #####################################################################################################################
+    struct AsyncFileWriter::State
+    {
+        struct Queued
+        {
+            std::string data;
+            std::size_t offset;
+            std::function<void(bool)> onWritten;
+        };
+
+        int32_t fileId;
+        std::uint32_t chunkSize;
+        std::deque<Queued> queue;
+        std::size_t pending;
+        bool sending;
+        bool failed;
+    };
+    //---------------------------------------------------------------------------------------------------------------------
+    AsyncFileWriter::AsyncFileWriter(int32_t fileId, std::uint32_t chunkSize)
+        : state_{std::make_shared<State>(State{
+              .fileId = fileId,
+              .chunkSize = std::max(chunkSize, std::uint32_t{1}),
+              .queue = {},
+              .pending = 0,
+              .sending = false,
+              .failed = false,
+          })}
+    {}
+    //---------------------------------------------------------------------------------------------------------------------
+    void AsyncFileWriter::write(std::string data, std::function<void(bool)> onWritten)
+    {
+        if (state_->failed)
+        {
+            if (onWritten)
+                onWritten(false);
+            return;
+        }
+        if (data.empty() && state_->queue.empty())
+        {
+            if (onWritten)
+                onWritten(true);
+            return;
+        }
+
+        state_->pending += data.size();
+        state_->queue.push_back({.data = std::move(data), .offset = 0, .onWritten = std::move(onWritten)});
+        sendNext(state_);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::size_t AsyncFileWriter::pending() const
+    {
+        return state_->pending;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    bool AsyncFileWriter::failed() const
+    {
+        return state_->failed;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void AsyncFileWriter::sendNext(std::shared_ptr<State> const& state)
+    {
+        if (state->sending || state->queue.empty())
+            return;
+
+        auto const& front = state->queue.front();
+        const auto size = std::min<std::size_t>(state->chunkSize, front.data.size() - front.offset);
+        state->sending = true;
+        RpcClient::getRemoteCallableWithResult(
+            "Nui::write",
+            [state, size]() {
+                state->sending = false;
+                auto& front = state->queue.front();
+                front.offset += size;
+                state->pending -= size;
+                if (front.offset == front.data.size())
+                {
+                    auto onWritten = std::move(front.onWritten);
+                    state->queue.pop_front();
+                    if (onWritten)
+                        onWritten(true);
+                }
+                sendNext(state);
+            },
+            [state](std::string const&) {
+                state->sending = false;
+                state->failed = true;
+                state->pending = 0;
+                auto queue = std::exchange(state->queue, {});
+                for (auto& queued : queue)
+                {
+                    if (queued.onWritten)
+                        queued.onWritten(false);
+                }
+            })(state->fileId, encodeData(std::string_view{front.data}.substr(front.offset, size)));
     }
     // #####################################################################################################################
     void
@@ -68,7 +288,7 @@ namespace Nui
         std::ios_base::openmode mode,
         std::function<void(std::optional<AsyncFile>&&)> onOpen)
     {
-        RpcClient::getRemoteCallableWithBackChannel("Nui::openFile", [onOpen = std::move(onOpen)](Nui::val response) {
+        RpcClient::getRemoteCallableWithResult("Nui::openFile", [onOpen = std::move(onOpen)](Nui::val response) {
             bool success{false};
             convertFromVal(response["success"], success);
             if (!success)
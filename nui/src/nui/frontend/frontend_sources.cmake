@@ -5,12 +5,20 @@ set(NUI_FRONTEND_SOURCES_RELATIVE
     attributes/impl/attribute.cpp
     components/dialog.cpp
     dom/dom.cpp
+    dom/prerendered_node.cpp
     event_system/event_context.cpp
+    event_system/event_delegation.cpp
     filesystem/file_dialog.cpp
     filesystem/file.cpp
+    utility/async_render.cpp
     utility/fragment_listener.cpp
     utility/functions.cpp
+    utility/lazy.cpp
+    utility/prerender.cpp
+    utility/render_profiler.cpp
     utility/stabilize.cpp
+    utility/static_html.cpp
+    rpc_client.cpp
     window.cpp
     screen.cpp
     environment_variables.cpp
@@ -0,0 +1,92 @@
+#include <nui/frontend/rpc_client.hpp>
+
+#include <unordered_map>
+#include <utility>
+
+namespace Nui
+{
+    namespace
+    {
+        constexpr static char const* responseFunctionName = "Nui::rpcResponse";
+
+        struct PendingRequest
+        {
+            std::function<void(Nui::val const&)> onResult;
+            std::function<void(std::string const&)> onError;
+        };
+
+        std::unordered_map<std::uint32_t, PendingRequest> pendingRequests;
+        std::uint32_t nextRequestId = 0;
+
+        void onResponse(Nui::val response)
+        {
+            using namespace std::string_literals;
+
+            std::uint32_t requestId = 0;
+            convertFromVal(response["id"], requestId);
+            auto iter = pendingRequests.find(requestId);
+            if (iter == pendingRequests.end())
+                return;
+            auto request = std::move(iter->second);
+            pendingRequests.erase(iter);
+
+            if (response.hasOwnProperty("error"))
+            {
+                std::string message;
+                convertFromVal(response["error"], message);
+                if (request.onError)
+                    request.onError(message);
+                else
+                    Console::error("Remote request failed: "s + message);
+                return;
+            }
+            request.onResult(response["value"]);
+        }
+
+        /// A single permanent function receives all responses.
+        bool installResponseFunction()
+        {
+            using namespace std::string_literals;
+            if (Nui::val::global("nui_rpc").isUndefined())
+            {
+                Console::error("rpc was not setup by backend"s);
+                return false;
+            }
+            auto frontend = Nui::val::global("nui_rpc")["frontend"];
+            if (!frontend.hasOwnProperty(responseFunctionName))
+            {
+                frontend.set(
+                    responseFunctionName,
+                    Nui::bind(
+                        [](Nui::val response) {
+                            onResponse(std::move(response));
+                        },
+                        std::placeholders::_1));
+            }
+            return true;
+        }
+    }
+
+    // #####################################################################################################################
+    std::uint32_t RpcClient::registerRequest(
+        std::function<void(Nui::val const&)> onResult,
+        std::function<void(std::string const&)> onError)
+    {
+        const auto requestId = nextRequestId++;
+        if (!installResponseFunction())
+            return requestId;
+        pendingRequests[requestId] = PendingRequest{.onResult = std::move(onResult), .onError = std::move(onError)};
+        return requestId;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RpcClient::cancelRequest(std::uint32_t requestId)
+    {
+        pendingRequests.erase(requestId);
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::size_t RpcClient::pendingRequestCount()
+    {
+        return pendingRequests.size();
+    }
+    // #####################################################################################################################
+}
@@ -0,0 +1,78 @@
+#include <nui/frontend/utility/async_render.hpp>
+
+#include <nui/frontend/event_system/event_context.hpp>
+#include <nui/frontend/utility/functions.hpp>
+
+#include <nui/frontend/val.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Nui::Detail
+{
+    namespace
+    {
+        thread_local std::vector<std::function<void()>> pendingCommits;
+        thread_local bool frameRequested = false;
+        thread_local std::vector<std::shared_ptr<AsyncOperation>> pendingOperations;
+
+        /// Drops settled operations and cancels those whose placeholder was destroyed before they settled.
+        void sweepPendingOperations()
+        {
+            std::erase_if(pendingOperations, [](std::shared_ptr<AsyncOperation> const& operation) {
+                if (operation->settled)
+                    return true;
+                if (!operation->placeholder.expired())
+                    return false;
+                operation->settled = true;
+                if (auto cancel = std::move(operation->cancel); cancel)
+                    cancel();
+                return true;
+            });
+        }
+
+        void flushAsyncRenders()
+        {
+            frameRequested = false;
+            // Commits may start new sources that resolve synchronously, so take the list first.
+            auto commits = std::move(pendingCommits);
+            pendingCommits.clear();
+            for (auto& commit : commits)
+                commit();
+            globalEventContext.executeActiveEventsImmediately();
+            sweepPendingOperations();
+        }
+    }
+
+    void commitAsyncRender(std::function<void()> commit)
+    {
+        pendingCommits.push_back(std::move(commit));
+        if (frameRequested)
+            return;
+
+        auto window = Nui::val::global("window");
+        if (window.isUndefined() || !window.hasOwnProperty("requestAnimationFrame"))
+        {
+            flushAsyncRenders();
+            return;
+        }
+
+        frameRequested = true;
+        window.call<void>(
+            "requestAnimationFrame",
+            Nui::bind(
+                [](Nui::val) {
+                    flushAsyncRenders();
+                },
+                std::placeholders::_1));
+    }
+
+    void trackAsyncOperation(std::shared_ptr<AsyncOperation> operation)
+    {
+        sweepPendingOperations();
+        // Sources may settle before they return.
+        if (operation->settled)
+            return;
+        pendingOperations.push_back(std::move(operation));
+    }
+}
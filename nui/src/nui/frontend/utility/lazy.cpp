@@ -0,0 +1,140 @@
+#include <nui/frontend/utility/lazy.hpp>
+
+#include <nui/frontend/dom/prerendered_node.hpp>
+#include <nui/frontend/event_system/event_context.hpp>
+#include <nui/frontend/utility/functions.hpp>
+
+#include <nui/frontend/val.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Nui
+{
+    namespace
+    {
+        struct LazyMount
+        {
+            ElementRenderer renderer;
+            std::weak_ptr<Dom::Element> placeholder;
+            std::optional<Nui::val> observer = std::nullopt;
+            std::optional<Nui::val> idleHandle = std::nullopt;
+            bool mounted = false;
+
+            void mount()
+            {
+                if (mounted)
+                    return;
+                stop();
+
+                if (auto element = placeholder.lock(); element)
+                {
+                    element->replaceElement(renderer);
+                    globalEventContext.executeActiveEventsImmediately();
+                }
+                renderer = {};
+            }
+
+            /// Stops waiting, the observer and the idle callback no longer reach this mount.
+            void stop()
+            {
+                mounted = true;
+                if (observer)
+                    observer->call<void>("disconnect");
+                if (idleHandle)
+                    Nui::val::global("window").call<void>("cancelIdleCallback", *idleHandle);
+                observer.reset();
+                idleHandle.reset();
+            }
+        };
+
+        /// Owns the mounts that wait for their placeholder. The JS callbacks only hold them weakly, because the mount
+        /// holds the observer and a strong reference would keep both alive forever.
+        thread_local std::vector<std::shared_ptr<LazyMount>> pendingMounts;
+
+        /// Drops mounts that are done and those whose placeholder was destroyed before it rendered.
+        void sweepPendingMounts()
+        {
+            std::erase_if(pendingMounts, [](std::shared_ptr<LazyMount> const& mount) {
+                if (mount->mounted)
+                    return true;
+                if (!mount->placeholder.expired())
+                    return false;
+                mount->stop();
+                mount->renderer = {};
+                return true;
+            });
+        }
+
+        void mountIfAlive(std::weak_ptr<LazyMount> const& weakMount)
+        {
+            if (auto mount = weakMount.lock(); mount)
+                mount->mount();
+            sweepPendingMounts();
+        }
+
+        bool windowHas(char const* name)
+        {
+            return Nui::val::global("window").hasOwnProperty(name);
+        }
+    }
+
+    ElementRenderer lazy(ElementRenderer renderer, LazyOptions options)
+    {
+        return [renderer = std::move(renderer), options = std::move(options)](
+                   Dom::Element& parentElement, Renderer const& gen) -> std::shared_ptr<Dom::Element> {
+            // Prerendered html contains the content, there is nothing to defer.
+            if (Dom::PrerenderScope::active())
+                return renderer(parentElement, gen);
+
+            const bool useObserver = options.whenVisible && windowHas("IntersectionObserver");
+            const bool useIdle = options.whenIdle && windowHas("requestIdleCallback");
+            if (!useObserver && !useIdle)
+                return renderer(parentElement, gen);
+
+            sweepPendingMounts();
+            auto placeholder = renderElement(gen, parentElement, HtmlElement{"div", options.placeholderAttributes});
+
+            auto mount = std::make_shared<LazyMount>();
+            mount->renderer = renderer;
+            mount->placeholder = placeholder;
+            pendingMounts.push_back(mount);
+            auto weakMount = std::weak_ptr<LazyMount>{mount};
+
+            if (useObserver)
+            {
+                auto observerOptions = Nui::val::object();
+                observerOptions.set("rootMargin", Nui::val{options.rootMargin});
+                auto onIntersection = Nui::bind(
+                    [weakMount](Nui::val entries, Nui::val) {
+                        const auto length = entries["length"].as<long long>();
+                        for (long long i = 0; i != length; ++i)
+                        {
+                            if (entries[static_cast<int>(i)]["isIntersecting"].as<bool>())
+                            {
+                                mountIfAlive(weakMount);
+                                return;
+                            }
+                        }
+                        sweepPendingMounts();
+                    },
+                    std::placeholders::_1,
+                    std::placeholders::_2);
+                mount->observer = Nui::val::global("IntersectionObserver").new_(onIntersection, observerOptions);
+                mount->observer->call<void>("observe", placeholder->val());
+            }
+            if (useIdle)
+            {
+                mount->idleHandle = Nui::val::global("window").call<Nui::val>(
+                    "requestIdleCallback",
+                    Nui::bind(
+                        [weakMount](Nui::val) {
+                            mountIfAlive(weakMount);
+                        },
+                        std::placeholders::_1));
+            }
+            return placeholder;
+        };
+    }
+}
@@ -0,0 +1,167 @@
+#include <nui/frontend/utility/prerender.hpp>
+
+#include <nui/frontend/dom/element.hpp>
+#include <nui/frontend/dom/prerendered_node.hpp>
+#include <nui/frontend/utility/static_html.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <string_view>
+
+namespace Nui
+{
+    namespace
+    {
+        void appendEscaped(std::string& html, std::string_view text)
+        {
+            for (auto c : text)
+            {
+                if (auto const* escaped = Detail::staticEscape(c); escaped)
+                    html += escaped;
+                else
+                    html += c;
+            }
+        }
+
+        /// The content of these is not parsed as html, escaping it would change it.
+        bool isRawTextElement(std::string_view tag)
+        {
+            return tag == "script" || tag == "style";
+        }
+
+        std::string lowerTagName(Nui::val const& element)
+        {
+            auto tag = element["tagName"].as<std::string>();
+            std::transform(tag.begin(), tag.end(), tag.begin(), [](unsigned char c) {
+                return std::tolower(c);
+            });
+            return tag;
+        }
+
+        void appendStartTag(std::string& html, std::string const& tag)
+        {
+            html += '<';
+            html += tag;
+        }
+
+        void appendAttribute(std::string& html, std::string_view name, std::string_view value)
+        {
+            html += ' ';
+            html += name;
+            html += "=\"";
+            appendEscaped(html, value);
+            html += '"';
+        }
+
+        void appendEndTag(std::string& html, std::string const& tag)
+        {
+            html += "</";
+            html += tag;
+            html += '>';
+        }
+
+        void serialize(std::string& html, Dom::PrerenderedNode const& node)
+        {
+            if (node.tagName.empty())
+            {
+                html += node.html;
+                return;
+            }
+
+            appendStartTag(html, node.tagName);
+            for (auto const& [name, value] : node.attributes)
+                appendAttribute(html, name, value);
+            html += '>';
+
+            if (Detail::staticIsVoidElement(node.tagName.c_str()))
+                return;
+
+            if (isRawTextElement(node.tagName))
+                html += node.text;
+            else
+                appendEscaped(html, node.text);
+            for (auto const& child : node.children)
+                serialize(html, *child);
+
+            appendEndTag(html, node.tagName);
+        }
+
+        constexpr int elementNode = 1;
+        constexpr int textNode = 3;
+        constexpr int commentNode = 8;
+
+        void serialize(std::string& html, Nui::val node)
+        {
+            switch (node["nodeType"].as<int>())
+            {
+                case textNode:
+                {
+                    const auto text = node["data"].as<std::string>();
+                    const auto parent = node["parentNode"];
+                    if (!parent.isNull() && !parent.isUndefined() && parent["nodeType"].as<int>() == elementNode &&
+                        isRawTextElement(lowerTagName(parent)))
+                        html += text;
+                    else
+                        appendEscaped(html, text);
+                    return;
+                }
+                case commentNode:
+                {
+                    html += "<!--";
+                    html += node["data"].as<std::string>();
+                    html += "-->";
+                    return;
+                }
+                case elementNode:
+                    break;
+                default:
+                    return;
+            }
+
+            const auto tag = lowerTagName(node);
+            appendStartTag(html, tag);
+            auto names = node.call<Nui::val>("getAttributeNames");
+            const auto attributeCount = names["length"].as<int>();
+            for (int i = 0; i != attributeCount; ++i)
+            {
+                const auto name = names[i].as<std::string>();
+                appendAttribute(html, name, node.call<Nui::val>("getAttribute", Nui::val{name}).as<std::string>());
+            }
+            html += '>';
+
+            if (Detail::staticIsVoidElement(tag.c_str()))
+                return;
+
+            // childNodes instead of children, text between elements must not get lost.
+            auto childNodes = node["childNodes"];
+            const auto childCount = childNodes["length"].as<int>();
+            for (int i = 0; i != childCount; ++i)
+                serialize(html, childNodes[i]);
+
+            appendEndTag(html, tag);
+        }
+    }
+
+    // #####################################################################################################################
+    std::string renderToHtml(ElementRenderer const& renderer)
+    {
+        // Elements only record what they would look like, no DOM node is created.
+        Dom::PrerenderScope scope;
+        auto container = std::make_shared<Dom::Element>(HtmlElement{"div", std::vector<Attribute>{}});
+        container->appendElement(renderer);
+
+        std::string html;
+        for (auto const& child : container->prerendered()->children)
+            serialize(html, *child);
+        return html;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::string toHtml(Nui::val const& element)
+    {
+        std::string html;
+        serialize(html, element);
+        return html;
+    }
+    // #####################################################################################################################
+}
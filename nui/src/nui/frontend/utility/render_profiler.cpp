@@ -0,0 +1,178 @@
+#include <nui/frontend/utility/render_profiler.hpp>
+
+#include <nui/frontend/rpc_client.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace Nui
+{
+    namespace
+    {
+        struct OpenScope
+        {
+            std::size_t index;
+            std::chrono::steady_clock::time_point start;
+            std::size_t domOperations;
+            std::size_t allocations;
+            bool hasComponent;
+        };
+
+        thread_local std::vector<RenderProfiler::Sample> recordedSamples;
+        thread_local std::vector<OpenScope> openScopes;
+        thread_local std::vector<std::string> components;
+
+        std::chrono::steady_clock::time_point origin()
+        {
+            static const auto origin = std::chrono::steady_clock::now();
+            return origin;
+        }
+
+        void appendJsonString(std::string& json, std::string const& str)
+        {
+            json.push_back('"');
+            for (auto c : str)
+            {
+                switch (c)
+                {
+                    case '"':
+                        json += "\\\"";
+                        break;
+                    case '\\':
+                        json += "\\\\";
+                        break;
+                    case '\n':
+                        json += "\\n";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            char escaped[7];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                            json += escaped;
+                        }
+                        else
+                            json.push_back(c);
+                }
+            }
+            json.push_back('"');
+        }
+    }
+
+    // #####################################################################################################################
+    std::vector<RenderProfiler::Sample> const& RenderProfiler::samples()
+    {
+        return recordedSamples;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RenderProfiler::clear()
+    {
+        recordedSamples.clear();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::size_t RenderProfiler::begin(char const* name, std::string const* component)
+    {
+        if (component)
+            components.push_back(*component);
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto index = recordedSamples.size();
+        recordedSamples.push_back(Sample{
+            .name = name,
+            .component = components.empty() ? std::string{} : components.back(),
+            .start = std::chrono::duration_cast<std::chrono::microseconds>(now - origin()),
+            .duration = {},
+            .domOperations = 0,
+            .allocations = 0,
+            .depth = openScopes.size(),
+        });
+        // Measure after the bookkeeping, so that it does not count itself.
+        openScopes.push_back(OpenScope{
+            .index = index,
+            .start = std::chrono::steady_clock::now(),
+            .domOperations = domOperations_,
+            .allocations = allocations_,
+            .hasComponent = component != nullptr,
+        });
+        return index;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RenderProfiler::end(std::size_t index)
+    {
+        if (openScopes.empty() || openScopes.back().index != index || index >= recordedSamples.size())
+            return;
+
+        const auto scope = openScopes.back();
+        openScopes.pop_back();
+
+        auto& sample = recordedSamples[index];
+        sample.duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - scope.start);
+        sample.domOperations = domOperations_ - scope.domOperations;
+        sample.allocations = allocations_ - scope.allocations;
+        if (scope.hasComponent)
+            components.pop_back();
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    std::string RenderProfiler::toChromeTrace()
+    {
+        std::string json = "{\"traceEvents\":[";
+        bool first = true;
+        for (auto const& sample : recordedSamples)
+        {
+            if (!first)
+                json.push_back(',');
+            first = false;
+
+            json += "{\"name\":";
+            appendJsonString(json, sample.component.empty() ? std::string{sample.name} : sample.component);
+            json += ",\"cat\":";
+            appendJsonString(json, sample.name);
+            json += ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+            json += std::to_string(sample.start.count());
+            json += ",\"dur\":";
+            json += std::to_string(sample.duration.count());
+            json += ",\"args\":{\"domOperations\":";
+            json += std::to_string(sample.domOperations);
+            json += ",\"allocations\":";
+            json += std::to_string(sample.allocations);
+            json += "}}";
+        }
+        json += "],\"displayTimeUnit\":\"ms\"}";
+        return json;
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RenderProfiler::saveTrace(std::string const& fileName)
+    {
+        RpcClient::getRemoteCallable("Nui::saveRenderProfile")(fileName, toChromeTrace());
+    }
+    //---------------------------------------------------------------------------------------------------------------------
+    void RenderProfiler::exposeOverRpc()
+    {
+        RpcClient::registerFunction("Nui::getRenderProfile", [](std::string const& responseId) {
+            RpcClient::getRemoteCallable(responseId)(toChromeTrace());
+        });
+    }
+    // #####################################################################################################################
+}
+
+#ifdef NUI_RENDER_PROFILER_COUNT_ALLOCATIONS
+void* operator new(std::size_t size)
+{
+    Nui::RenderProfiler::countAllocation();
+    if (size == 0)
+        size = 1;
+    if (void* memory = std::malloc(size); memory)
+        return memory;
+    throw std::bad_alloc{};
+}
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
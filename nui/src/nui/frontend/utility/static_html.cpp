@@ -0,0 +1,37 @@
+#include <nui/frontend/utility/static_html.hpp>
+
+#include <nui/frontend/val.hpp>
+
+#include <memory>
+
+namespace Nui::Detail
+{
+    ElementRenderer renderStaticHtml(std::string html)
+    {
+        return [html = std::move(html)](Dom::Element& element, Renderer const& gen) -> std::shared_ptr<Dom::Element> {
+            switch (gen.type)
+            {
+                case RendererType::Append:
+                    return element.insertHtml(element.childCount(), html.c_str());
+                case RendererType::Fragment:
+                {
+                    if (element.prerendered())
+                    {
+                        auto node = std::make_shared<Dom::PrerenderedNode>(Dom::PrerenderedNode{.html = html});
+                        element.prerendered()->appendChild(node);
+                        return std::make_shared<Dom::Element>(std::move(node));
+                    }
+                    element.val().call<void>("insertAdjacentHTML", Nui::val{"beforeend"}, Nui::val{html});
+                    return std::make_shared<Dom::Element>(element.val()["lastElementChild"]);
+                }
+                case RendererType::Insert:
+                    return element.insertHtml(gen.metadata, html.c_str());
+                case RendererType::Replace:
+                    return element.replaceWithHtml(html.c_str());
+                case RendererType::Inplace:
+                    return element.shared_from_base<Dom::Element>();
+            }
+            return nullptr;
+        };
+    }
+}
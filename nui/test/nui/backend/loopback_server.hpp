@@ -0,0 +1,251 @@
+#pragma once
+
+#include <boost/asio/buffers_iterator.hpp>
+#include <boost/asio/completion_condition.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Nui::Tests
+{
+    /**
+     * @brief A minimal HTTP/1.1 server on 127.0.0.1 and a free port. Every request is answered by a handler on the
+     * thread of the server, connections are kept alive. Counts the requests per path.
+     */
+    class LoopbackServer
+    {
+      public:
+        struct Request
+        {
+            std::string method;
+            /// Without the query.
+            std::string path;
+            /// Names are lower case.
+            std::unordered_map<std::string, std::string> headers;
+            std::string body;
+
+            std::string header(std::string const& name) const
+            {
+                auto iter = headers.find(name);
+                return iter != headers.end() ? iter->second : std::string{};
+            }
+        };
+
+        struct Response
+        {
+            int status = 200;
+            std::vector<std::pair<std::string, std::string>> headers = {};
+            std::string body = {};
+        };
+
+        using Handler = std::function<Response(Request const&)>;
+
+        explicit LoopbackServer(Handler handler)
+            : handler_{std::move(handler)}
+            , context_{}
+            , acceptor_{context_, {boost::asio::ip::make_address("127.0.0.1"), 0}}
+            , hitsGuard_{}
+            , hits_{}
+            , thread_{}
+        {
+            accept();
+            thread_ = std::thread{[this]() {
+                context_.run();
+            }};
+        }
+        LoopbackServer(LoopbackServer const&) = delete;
+        LoopbackServer(LoopbackServer&&) = delete;
+        LoopbackServer& operator=(LoopbackServer const&) = delete;
+        LoopbackServer& operator=(LoopbackServer&&) = delete;
+        ~LoopbackServer()
+        {
+            context_.stop();
+            thread_.join();
+        }
+
+        std::string url(std::string const& target) const
+        {
+            return "http://127.0.0.1:" + std::to_string(acceptor_.local_endpoint().port()) + target;
+        }
+
+        /**
+         * @brief The number of requests that reached the server for a path.
+         */
+        int hits(std::string const& path) const
+        {
+            std::scoped_lock lock{hitsGuard_};
+            auto iter = hits_.find(path);
+            return iter != hits_.end() ? iter->second : 0;
+        }
+
+        /**
+         * @brief Formats a point in time as an http date (RFC 9110 IMF-fixdate).
+         */
+        static std::string httpDate(std::chrono::system_clock::time_point time = std::chrono::system_clock::now())
+        {
+            const auto seconds = std::chrono::system_clock::to_time_t(time);
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &seconds);
+#else
+            gmtime_r(&seconds, &tm);
+#endif
+            char buffer[64];
+            const auto length = std::strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+            return {buffer, length};
+        }
+
+      private:
+        class Session : public std::enable_shared_from_this<Session>
+        {
+          public:
+            Session(LoopbackServer& server, boost::asio::ip::tcp::socket socket)
+                : server_{server}
+                , socket_{std::move(socket)}
+                , buffer_{}
+            {}
+
+            void readHead()
+            {
+                boost::asio::async_read_until(
+                    socket_,
+                    buffer_,
+                    "\r\n\r\n",
+                    [self = shared_from_this()](boost::system::error_code const& ec, std::size_t length) {
+                        if (!ec)
+                            self->onHead(length);
+                    });
+            }
+
+          private:
+            void onHead(std::size_t length)
+            {
+                const auto data = buffer_.data();
+                auto head = std::string{
+                    boost::asio::buffers_begin(data), boost::asio::buffers_begin(data) + static_cast<long>(length)};
+                buffer_.consume(length);
+
+                auto request = std::make_shared<Request>();
+                auto lineEnd = head.find("\r\n");
+                const auto requestLine = head.substr(0, lineEnd);
+                const auto firstSpace = requestLine.find(' ');
+                const auto secondSpace = requestLine.find(' ', firstSpace + 1);
+                request->method = requestLine.substr(0, firstSpace);
+                const auto target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+                request->path = target.substr(0, target.find('?'));
+
+                while (lineEnd != std::string::npos && lineEnd + 2 < head.size())
+                {
+                    const auto begin = lineEnd + 2;
+                    lineEnd = head.find("\r\n", begin);
+                    const auto line = head.substr(begin, lineEnd - begin);
+                    const auto colon = line.find(':');
+                    if (colon == std::string::npos)
+                        continue;
+                    auto name = line.substr(0, colon);
+                    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) {
+                        return static_cast<char>(std::tolower(c));
+                    });
+                    const auto valueBegin = line.find_first_not_of(' ', colon + 1);
+                    request->headers[name] = valueBegin == std::string::npos ? std::string{} : line.substr(valueBegin);
+                }
+
+                const auto contentLength = request->header("content-length");
+                const auto bodySize = contentLength.empty() ? std::size_t{0} : std::stoul(contentLength);
+                if (buffer_.size() >= bodySize)
+                    return onBody(request, bodySize);
+
+                boost::asio::async_read(
+                    socket_,
+                    buffer_,
+                    boost::asio::transfer_exactly(bodySize - buffer_.size()),
+                    [self = shared_from_this(), request, bodySize](boost::system::error_code const& ec, std::size_t) {
+                        if (!ec)
+                            self->onBody(request, bodySize);
+                    });
+            }
+
+            void onBody(std::shared_ptr<Request> const& request, std::size_t bodySize)
+            {
+                const auto data = buffer_.data();
+                request->body = std::string{
+                    boost::asio::buffers_begin(data), boost::asio::buffers_begin(data) + static_cast<long>(bodySize)};
+                buffer_.consume(bodySize);
+
+                {
+                    std::scoped_lock lock{server_.hitsGuard_};
+                    ++server_.hits_[request->path];
+                }
+                const auto response = server_.handler_(*request);
+
+                auto message = std::make_shared<std::string>(
+                    "HTTP/1.1 " + std::to_string(response.status) + " " + reason(response.status) + "\r\n");
+                for (auto const& [name, value] : response.headers)
+                    *message += name + ": " + value + "\r\n";
+                *message += "Content-Length: " + std::to_string(response.body.size()) + "\r\n\r\n";
+                if (request->method != "HEAD")
+                    *message += response.body;
+
+                boost::asio::async_write(
+                    socket_,
+                    boost::asio::buffer(*message),
+                    [self = shared_from_this(), message](boost::system::error_code const& ec, std::size_t) {
+                        if (!ec)
+                            self->readHead();
+                    });
+            }
+
+            static std::string reason(int status)
+            {
+                switch (status)
+                {
+                    case 200:
+                        return "OK";
+                    case 304:
+                        return "Not Modified";
+                    default:
+                        return "Status";
+                }
+            }
+
+          private:
+            LoopbackServer& server_;
+            boost::asio::ip::tcp::socket socket_;
+            boost::asio::streambuf buffer_;
+        };
+
+        void accept()
+        {
+            acceptor_.async_accept([this](boost::system::error_code const& ec, boost::asio::ip::tcp::socket socket) {
+                if (ec)
+                    return;
+                std::make_shared<Session>(*this, std::move(socket))->readHead();
+                accept();
+            });
+        }
+
+      private:
+        Handler handler_;
+        boost::asio::io_context context_;
+        boost::asio::ip::tcp::acceptor acceptor_;
+        mutable std::mutex hitsGuard_;
+        std::unordered_map<std::string, int> hits_;
+        std::thread thread_;
+    };
+}
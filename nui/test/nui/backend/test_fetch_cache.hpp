@@ -0,0 +1,327 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "loopback_server.hpp"
+
+#include <rpc_addons/fetch_cache.hpp>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace Nui::Tests
+{
+    class TestFetchCache : public ::testing::Test
+    {
+      protected:
+        TestFetchCache()
+            : server_{[](LoopbackServer::Request const& request) {
+                return respond(request);
+            }}
+            , pool_{2}
+            , client_{pool_.executor()}
+            , directory_{
+                  std::filesystem::temp_directory_path() /
+                  ("nui-fetch-cache-" +
+                   std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()))}
+            , cache_{}
+            , requestId_{0}
+        {}
+
+        ~TestFetchCache() override
+        {
+            pool_.stop();
+            pool_.join();
+            cache_.reset();
+            std::error_code ec;
+            std::filesystem::remove_all(directory_, ec);
+        }
+
+        /**
+         * @brief Creates the cache, or replaces it with a new one that finds what the old one left on the disk.
+         */
+        void makeCache(std::size_t memoryBudget = 10000, std::size_t diskBudget = 100000)
+        {
+            cache_.reset();
+            cache_ = std::make_unique<FetchCache>(FetchCacheOptions{
+                .memoryBudget = memoryBudget,
+                .diskDirectory = directory_,
+                .diskBudget = diskBudget,
+            });
+        }
+
+        /**
+         * @brief Does what Nui::fetch does with the cache and the client.
+         */
+        FetchResult fetch(std::string const& target, FetchOptions const& options = {})
+        {
+            const auto url = server_.url(target);
+            auto lookup = cache_->lookup(url, options);
+            if (lookup.response)
+                return std::move(*lookup.response);
+            if (lookup.unsatisfiable)
+                return FetchResult{
+                    .curlCode = CURLE_OK,
+                    .status = 504,
+                    .proxyStatus = 0,
+                    .downloadSize = 0,
+                    .redirectUrl = {},
+                    .body = {},
+                    .headers = {},
+                };
+
+            auto requestOptions = options;
+            for (auto& [name, value] : lookup.conditionalHeaders)
+                requestOptions.headers[name] = std::move(value);
+            // Shared, a late completion must not outlive the promise when the wait times out.
+            auto promise = std::make_shared<std::promise<FetchResult>>();
+            auto future = promise->get_future();
+            client_.start(
+                ++requestId_, url, requestOptions, [this, url, options, promise](FetchResult&& result) {
+                    promise->set_value(cache_->complete(url, options, std::move(result)));
+                });
+            if (future.wait_for(std::chrono::seconds{10}) != std::future_status::ready)
+            {
+                ADD_FAILURE() << "No response for " << target;
+                return FetchResult{};
+            }
+            return future.get();
+        }
+
+        static FetchOptions withCacheMode(std::string mode)
+        {
+            FetchOptions options;
+            options.cache = std::move(mode);
+            return options;
+        }
+
+        std::size_t filesOnDisk() const
+        {
+            return static_cast<std::size_t>(std::distance(
+                std::filesystem::directory_iterator{directory_}, std::filesystem::directory_iterator{}));
+        }
+
+      private:
+        static LoopbackServer::Response respond(LoopbackServer::Request const& request)
+        {
+            const auto date = LoopbackServer::httpDate();
+            auto const& path = request.path;
+            if (request.method == "POST")
+                return {.status = 200, .headers = {}, .body = "posted"};
+            if (path.starts_with("/fresh"))
+                return {.status = 200, .headers = {{"Cache-Control", "max-age=60"}, {"Date", date}}, .body = "fresh"};
+            if (path.starts_with("/etag"))
+            {
+                const auto headers = std::vector<std::pair<std::string, std::string>>{
+                    {"ETag", "\"v1\""}, {"Cache-Control", "no-cache"}, {"Date", date}};
+                if (request.header("if-none-match") == "\"v1\"")
+                    return {.status = 304, .headers = headers, .body = {}};
+                return {.status = 200, .headers = headers, .body = "etag"};
+            }
+            if (path.starts_with("/lastmod"))
+            {
+                const auto lastModified = std::string{"Sun, 06 Nov 1994 08:49:37 GMT"};
+                if (request.header("if-modified-since") == lastModified)
+                    return {.status = 304, .headers = {{"Cache-Control", "max-age=0"}, {"Date", date}}, .body = {}};
+                return {
+                    .status = 200,
+                    .headers = {{"Last-Modified", lastModified}, {"Cache-Control", "max-age=0"}, {"Date", date}},
+                    .body = "lastmod",
+                };
+            }
+            if (path.starts_with("/nostore"))
+                return {.status = 200, .headers = {{"Cache-Control", "no-store"}, {"Date", date}}, .body = "nostore"};
+            if (path.starts_with("/vary"))
+                return {
+                    .status = 200,
+                    .headers = {{"Cache-Control", "max-age=60"}, {"Vary", "X-Lang"}},
+                    .body = "lang " + request.header("x-lang"),
+                };
+            if (path.starts_with("/expires"))
+                return {
+                    .status = 200,
+                    .headers =
+                        {{"Date", date},
+                         {"Expires", LoopbackServer::httpDate(std::chrono::system_clock::now() + std::chrono::minutes{1})}},
+                    .body = "expires",
+                };
+            if (path.starts_with("/big"))
+                return {.status = 200, .headers = {{"Cache-Control", "max-age=60"}}, .body = std::string(4000, 'x')};
+            if (path.starts_with("/binaryheader"))
+                return {
+                    .status = 200,
+                    .headers = {{"Cache-Control", "max-age=60"}, {"X-Raw", "\xff\xfe"}},
+                    .body = "binary header",
+                };
+            return {.status = 200, .headers = {}, .body = "plain"};
+        }
+
+      protected:
+        LoopbackServer server_;
+        boost::asio::thread_pool pool_;
+        FetchClient client_;
+        std::filesystem::path directory_;
+        std::unique_ptr<FetchCache> cache_;
+        std::uint64_t requestId_;
+    };
+
+    TEST_F(TestFetchCache, FreshResponseIsServedFromTheCache)
+    {
+        makeCache();
+        EXPECT_EQ(fetch("/fresh").body, "fresh");
+        const auto cached = fetch("/fresh");
+        EXPECT_EQ(cached.status, 200);
+        EXPECT_EQ(cached.body, "fresh");
+        EXPECT_EQ(server_.hits("/fresh"), 1);
+    }
+
+    TEST_F(TestFetchCache, CacheModesBypassTheStoredResponse)
+    {
+        makeCache();
+        fetch("/fresh");
+        EXPECT_EQ(fetch("/fresh", withCacheMode("no-cache")).body, "fresh");
+        EXPECT_EQ(server_.hits("/fresh"), 2);
+        fetch("/fresh", withCacheMode("reload"));
+        EXPECT_EQ(server_.hits("/fresh"), 3);
+        fetch("/nostore");
+        fetch("/nostore");
+        EXPECT_EQ(server_.hits("/nostore"), 2);
+    }
+
+    TEST_F(TestFetchCache, StaleResponsesAreRevalidated)
+    {
+        makeCache();
+        EXPECT_EQ(fetch("/etag").body, "etag");
+        auto revalidated = fetch("/etag");
+        EXPECT_EQ(revalidated.status, 200);
+        EXPECT_EQ(revalidated.body, "etag");
+        EXPECT_EQ(server_.hits("/etag"), 2);
+
+        EXPECT_EQ(fetch("/lastmod").body, "lastmod");
+        revalidated = fetch("/lastmod");
+        EXPECT_EQ(revalidated.status, 200);
+        EXPECT_EQ(revalidated.body, "lastmod");
+        EXPECT_EQ(cache_->statistics().revalidations, 2u);
+    }
+
+    TEST_F(TestFetchCache, ConditionalRequestsOfTheUserBypassTheCache)
+    {
+        makeCache();
+        fetch("/etag");
+        FetchOptions options;
+        options.headers["If-None-Match"] = "\"v1\"";
+        EXPECT_EQ(fetch("/etag", options).status, 304);
+    }
+
+    TEST_F(TestFetchCache, VaryingResponsesAreKeptPerRequestHeader)
+    {
+        makeCache();
+        FetchOptions german;
+        german.headers["X-Lang"] = "de";
+        FetchOptions english;
+        english.headers["x-lang"] = "en";
+        EXPECT_EQ(fetch("/vary", german).body, "lang de");
+        EXPECT_EQ(fetch("/vary", german).body, "lang de");
+        EXPECT_EQ(fetch("/vary", english).body, "lang en");
+        EXPECT_EQ(server_.hits("/vary"), 2);
+    }
+
+    TEST_F(TestFetchCache, ExpiresHeaderMakesResponsesFresh)
+    {
+        makeCache();
+        fetch("/expires");
+        fetch("/expires");
+        EXPECT_EQ(server_.hits("/expires"), 1);
+    }
+
+    TEST_F(TestFetchCache, ResponsesWithoutFreshnessOrValidatorsAreNotStored)
+    {
+        makeCache();
+        fetch("/plain");
+        fetch("/plain");
+        EXPECT_EQ(server_.hits("/plain"), 2);
+    }
+
+    TEST_F(TestFetchCache, OnlyIfCachedDoesNotGoToTheNetwork)
+    {
+        makeCache();
+        EXPECT_EQ(fetch("/never", withCacheMode("only-if-cached")).status, 504);
+        EXPECT_EQ(server_.hits("/never"), 0);
+        fetch("/fresh");
+        EXPECT_EQ(fetch("/fresh", withCacheMode("only-if-cached")).body, "fresh");
+    }
+
+    TEST_F(TestFetchCache, UnsafeMethodInvalidatesTheUrl)
+    {
+        makeCache();
+        fetch("/fresh");
+        FetchOptions post;
+        post.method = "POST";
+        post.body = "x";
+        EXPECT_EQ(fetch("/fresh", post).body, "posted");
+        fetch("/fresh");
+        EXPECT_EQ(server_.hits("/fresh"), 3);
+    }
+
+    TEST_F(TestFetchCache, MemoryIsEvictedToTheDisk)
+    {
+        makeCache();
+        for (int i = 0; i != 4; ++i)
+            fetch("/big" + std::to_string(i));
+        const auto statistics = cache_->statistics();
+        EXPECT_LE(statistics.memoryBytes, 10000u);
+        EXPECT_GE(statistics.evictions, 2u);
+
+        fetch("/big0");
+        EXPECT_EQ(server_.hits("/big0"), 1);
+    }
+
+    TEST_F(TestFetchCache, DiskEntriesSurviveARestart)
+    {
+        makeCache();
+        fetch("/fresh");
+        FetchOptions memoryOnly;
+        memoryOnly.cacheOnDisk = false;
+        fetch("/fresh?memory", memoryOnly);
+
+        makeCache();
+        EXPECT_EQ(fetch("/fresh").body, "fresh");
+        EXPECT_EQ(server_.hits("/fresh"), 2);
+        fetch("/fresh?memory");
+        EXPECT_EQ(server_.hits("/fresh"), 3);
+
+        cache_->clear();
+        EXPECT_EQ(cache_->statistics().diskEntries, 0u);
+    }
+
+    TEST_F(TestFetchCache, DiskBudgetIsKept)
+    {
+        makeCache(0, 9000);
+        for (int i = 0; i != 4; ++i)
+            fetch("/big" + std::to_string(i));
+        const auto statistics = cache_->statistics();
+        EXPECT_EQ(statistics.diskEntries, 2u);
+        EXPECT_LE(statistics.diskBytes, 9000u);
+        EXPECT_EQ(statistics.memoryEntries, 0u);
+        EXPECT_EQ(filesOnDisk(), 2u);
+
+        fetch("/big3");
+        EXPECT_EQ(server_.hits("/big3"), 1);
+    }
+
+    TEST_F(TestFetchCache, HeadersThatAreNotUtf8AreNotWrittenToDisk)
+    {
+        makeCache();
+        EXPECT_EQ(fetch("/binaryheader").body, "binary header");
+        EXPECT_EQ(fetch("/binaryheader").body, "binary header");
+        EXPECT_EQ(server_.hits("/binaryheader"), 1);
+        EXPECT_EQ(cache_->statistics().diskEntries, 0u);
+        EXPECT_EQ(filesOnDisk(), 0u);
+    }
+}
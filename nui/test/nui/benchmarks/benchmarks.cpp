@@ -0,0 +1,378 @@
+#include "../engine/global_object.hpp"
+#include "../engine/document.hpp"
+
+#include <nui/frontend/attributes.hpp>
+#include <nui/frontend/dom/dom.hpp>
+#include <nui/frontend/elements.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::size_t allocationCounter = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocationCounter;
+    if (size == 0)
+        size = 1;
+    if (void* memory = std::malloc(size); memory)
+        return memory;
+    throw std::bad_alloc{};
+}
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace Nui::Benchmarks
+{
+    using namespace Nui::Tests;
+
+    struct Result
+    {
+        std::string name;
+        std::chrono::microseconds time;
+        std::size_t allocations;
+        std::size_t domCalls;
+        std::map<std::string, std::size_t> domCallsByName;
+    };
+
+    struct BaselineEntry
+    {
+        std::size_t allocations;
+        std::size_t domCalls;
+    };
+
+    /// Fresh mock document and dom for every scenario, like CommonTestFixture.
+    class Environment
+    {
+      public:
+        Environment()
+            : preConstructionHelper_{[]() {
+                Engine::resetGlobals();
+                return 0;
+            }()}
+            , document_{}
+            , dom_{}
+        {}
+
+        template <typename T>
+        void render(T&& factory)
+        {
+            dom_.setBody(std::forward<T>(factory));
+        }
+
+      private:
+        int preConstructionHelper_;
+        Engine::Document document_;
+        Dom::Dom dom_;
+    };
+
+    struct Row
+    {
+        int id;
+        std::string label;
+    };
+
+    std::vector<Row> makeRows(int count, int firstId = 0)
+    {
+        std::vector<Row> rows;
+        rows.reserve(static_cast<std::size_t>(count));
+        for (int i = 0; i != count; ++i)
+            rows.push_back(Row{.id = firstId + i, .label = "row " + std::to_string(firstId + i)});
+        return rows;
+    }
+
+    void renderRows(Environment& environment, Observed<std::vector<Row>>& rows)
+    {
+        using Nui::Elements::tbody;
+        using Nui::Elements::tr;
+        using Nui::Elements::td;
+        using Nui::Attributes::class_;
+
+        environment.render(tbody{}(range(rows), [](long long, Row const& row) {
+            return tr{class_ = "row"}(td{}(std::to_string(row.id)), td{}(row.label));
+        }));
+    }
+
+    void update()
+    {
+        globalEventContext.executeActiveEventsImmediately();
+    }
+
+    /**
+     * @brief Runs setup outside of the measurement and then measures the scenario.
+     */
+    Result measure(std::string name, std::function<void(Environment&)> const& setup, std::function<void()> scenario)
+    {
+        Environment environment;
+        setup(environment);
+
+        Engine::domCallCounts().clear();
+        const auto allocationsBefore = allocationCounter;
+        const auto start = std::chrono::steady_clock::now();
+        scenario();
+        const auto end = std::chrono::steady_clock::now();
+        const auto allocations = allocationCounter - allocationsBefore;
+
+        auto domCallsByName = Engine::domCallCounts();
+        return Result{
+            .name = std::move(name),
+            .time = std::chrono::duration_cast<std::chrono::microseconds>(end - start),
+            .allocations = allocations,
+            .domCalls = std::accumulate(
+                domCallsByName.begin(),
+                domCallsByName.end(),
+                std::size_t{0},
+                [](std::size_t sum, auto const& entry) {
+                    return sum + entry.second;
+                }),
+            .domCallsByName = std::move(domCallsByName),
+        };
+    }
+
+    Result mountRows(int count)
+    {
+        Observed<std::vector<Row>> rows;
+        Environment* target = nullptr;
+        return measure(
+            "mount_" + std::to_string(count),
+            [&target](Environment& environment) {
+                target = &environment;
+            },
+            [&target, &rows, count]() {
+                rows = makeRows(count);
+                renderRows(*target, rows);
+            });
+    }
+
+    /// Mounts rows and then measures the modification.
+    Result rowScenario(std::string name, int count, std::function<void(Observed<std::vector<Row>>&)> modification)
+    {
+        Observed<std::vector<Row>> rows;
+        return measure(
+            std::move(name),
+            [&rows, count](Environment& environment) {
+                rows = makeRows(count);
+                renderRows(environment, rows);
+                update();
+            },
+            [&rows, &modification]() {
+                modification(rows);
+                update();
+            });
+    }
+
+    Result deepReactiveToggle(int depth, int toggles)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        Observed<bool> flag = true;
+        std::function<ElementRenderer(int)> level = [&flag, &level](int remaining) -> ElementRenderer {
+            if (remaining == 0)
+                return span{}("leaf");
+            return div{}(observe(flag), [&flag, &level, remaining]() -> ElementRenderer {
+                if (*flag)
+                    return div{}(level(remaining - 1), span{}("sibling"));
+                return span{}("collapsed");
+            });
+        };
+
+        return measure(
+            "deep_toggle_" + std::to_string(depth),
+            [&level, depth](Environment& environment) {
+                environment.render(level(depth));
+                update();
+            },
+            [&flag, toggles]() {
+                for (int i = 0; i != toggles; ++i)
+                {
+                    flag = !flag.value();
+                    update();
+                }
+            });
+    }
+
+    void printHeader()
+    {
+        std::cout << std::left << std::setw(22) << "scenario" << std::right << std::setw(12) << "time [us]"
+                  << std::setw(14) << "allocations" << std::setw(12) << "dom calls"
+                  << "  by function" << std::endl;
+    }
+
+    void print(Result const& result)
+    {
+        std::cout << std::left << std::setw(22) << result.name << std::right << std::setw(12) << result.time.count()
+                  << std::setw(14) << result.allocations << std::setw(12) << result.domCalls << " ";
+        for (auto const& [name, count] : result.domCallsByName)
+            std::cout << ' ' << name << '=' << count;
+        std::cout << std::endl;
+    }
+
+    std::vector<Result> runAll()
+    {
+        std::vector<Result> results;
+        const auto run = [&results](Result result) {
+            print(result);
+            results.push_back(std::move(result));
+        };
+
+        printHeader();
+        run(mountRows(1'000));
+        run(mountRows(10'000));
+        run(rowScenario("append_1000", 1'000, [](auto& rows) {
+            for (auto const& row : makeRows(1'000, 1'000))
+                rows.push_back(row);
+        }));
+        run(rowScenario("prepend_100", 1'000, [](auto& rows) {
+            for (auto const& row : makeRows(100, 1'000))
+                rows.insert(rows.begin(), row);
+        }));
+        run(rowScenario("modify_every_10th", 1'000, [](auto& rows) {
+            for (std::size_t i = 0; i < rows.size(); i += 10)
+                rows[i] = Row{.id = static_cast<int>(i), .label = "modified"};
+        }));
+        run(rowScenario("erase_front_10", 1'000, [](auto& rows) {
+            for (int i = 0; i != 10; ++i)
+                rows.erase(rows.begin());
+        }));
+        run(rowScenario("sort_descending", 1'000, [](auto& rows) {
+            auto sorted = rows.value();
+            std::sort(sorted.begin(), sorted.end(), [](auto const& lhs, auto const& rhs) {
+                return lhs.id > rhs.id;
+            });
+            rows = std::move(sorted);
+        }));
+        run(rowScenario("clear", 1'000, [](auto& rows) {
+            rows.clear();
+        }));
+        run(deepReactiveToggle(10, 100));
+        return results;
+    }
+
+    std::optional<std::map<std::string, BaselineEntry>> readBaseline(std::string const& path)
+    {
+        std::ifstream reader{path};
+        if (!reader)
+            return std::nullopt;
+        std::map<std::string, BaselineEntry> baseline;
+        std::string line;
+        while (std::getline(reader, line))
+        {
+            if (line.empty() || line.front() == '#')
+                continue;
+            std::istringstream lineStream{line};
+            std::string name;
+            BaselineEntry entry{};
+            if (lineStream >> name >> entry.domCalls >> entry.allocations)
+                baseline[name] = entry;
+        }
+        return baseline;
+    }
+
+    void writeBaseline(std::string const& path, std::vector<Result> const& results)
+    {
+        std::ofstream writer{path};
+        writer << "# scenario dom_calls allocations\n";
+        for (auto const& result : results)
+            writer << result.name << ' ' << result.domCalls << ' ' << result.allocations << '\n';
+    }
+
+    /**
+     * @brief DOM calls must not increase at all and every scenario needs a baseline entry. Allocations depend on the
+     * standard library and compiler, so a change beyond the tolerance is only reported. Wall time is only reported as
+     * well, it is too noisy to fail on.
+     */
+    bool compare(
+        std::vector<Result> const& results,
+        std::map<std::string, BaselineEntry> const& baseline,
+        double allocationTolerance)
+    {
+        bool success = true;
+        for (auto const& result : results)
+        {
+            auto iter = baseline.find(result.name);
+            if (iter == baseline.end())
+            {
+                std::cout << "MISSING baseline for " << result.name << '\n';
+                success = false;
+                continue;
+            }
+            if (result.domCalls > iter->second.domCalls)
+            {
+                std::cout << "REGRESSION " << result.name << ": dom calls " << iter->second.domCalls << " -> "
+                          << result.domCalls << '\n';
+                success = false;
+            }
+            const auto allowedAllocations =
+                static_cast<double>(iter->second.allocations) * (1.0 + allocationTolerance);
+            if (static_cast<double>(result.allocations) > allowedAllocations)
+            {
+                std::cout << "note " << result.name << ": allocations " << iter->second.allocations << " -> "
+                          << result.allocations << '\n';
+            }
+        }
+        return success;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Nui::Benchmarks;
+
+    std::optional<std::string> baselinePath;
+    std::optional<std::string> writeBaselinePath;
+    double allocationTolerance = 0.1;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--baseline" && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (argument == "--write-baseline" && i + 1 < argc)
+            writeBaselinePath = argv[++i];
+        else if (argument == "--allocation-tolerance" && i + 1 < argc)
+            allocationTolerance = std::stod(argv[++i]);
+        else
+        {
+            std::cerr << "usage: " << argv[0]
+                      << " [--baseline <file>] [--write-baseline <file>] [--allocation-tolerance <fraction>]\n";
+            return 2;
+        }
+    }
+
+    const auto results = runAll();
+
+    if (writeBaselinePath)
+        writeBaseline(*writeBaselinePath, results);
+    if (!baselinePath)
+        return 0;
+    const auto baseline = readBaseline(*baselinePath);
+    if (!baseline)
+    {
+        std::cerr << "cannot read baseline " << *baselinePath << '\n';
+        return 1;
+    }
+    if (!compare(results, *baseline, allocationTolerance))
+        return 1;
+    return 0;
+}
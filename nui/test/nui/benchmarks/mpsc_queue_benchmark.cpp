@@ -0,0 +1,139 @@
+#include <nui/data_structures/mpsc_queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Nui::Benchmarks
+{
+    struct Message
+    {
+        std::uint32_t producer;
+        std::uint32_t sequence;
+    };
+
+    /// What the window used before: every producer takes the same lock.
+    class LockedQueue
+    {
+      public:
+        void push(Message message)
+        {
+            std::scoped_lock lock{guard_};
+            messages_.push_back(message);
+        }
+
+        template <typename FunctionT>
+        std::size_t drain(FunctionT&& function)
+        {
+            std::vector<Message> messages;
+            {
+                std::scoped_lock lock{guard_};
+                messages.swap(messages_);
+            }
+            for (auto const& message : messages)
+                function(Message{message});
+            return messages.size();
+        }
+
+      private:
+        std::mutex guard_;
+        std::vector<Message> messages_;
+    };
+
+    struct Result
+    {
+        std::chrono::microseconds time;
+        bool ordered;
+    };
+
+    /**
+     * @brief Producers push concurrently while one consumer drains, like backend threads calling the frontend. Also
+     * checks that every message arrives exactly once and in order per producer.
+     */
+    template <typename QueueT>
+    Result run(std::uint32_t producerCount, std::uint32_t messagesPerProducer)
+    {
+        QueueT queue;
+        std::atomic<bool> start{false};
+        std::vector<std::thread> producers;
+        producers.reserve(producerCount);
+        for (std::uint32_t producer = 0; producer != producerCount; ++producer)
+        {
+            producers.emplace_back([&queue, &start, producer, messagesPerProducer]() {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (std::uint32_t sequence = 0; sequence != messagesPerProducer; ++sequence)
+                    queue.push(Message{.producer = producer, .sequence = sequence});
+            });
+        }
+
+        std::vector<std::uint32_t> expected(producerCount, 0);
+        bool ordered = true;
+        const std::uint64_t total = static_cast<std::uint64_t>(producerCount) * messagesPerProducer;
+        std::uint64_t received = 0;
+
+        const auto startTime = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        while (received != total)
+        {
+            const auto drained = queue.drain([&expected, &ordered](Message&& message) {
+                ordered = ordered && message.sequence == expected[message.producer];
+                expected[message.producer] = message.sequence + 1;
+            });
+            if (drained == 0)
+                std::this_thread::yield();
+            received += drained;
+        }
+        const auto endTime = std::chrono::steady_clock::now();
+
+        for (auto& producer : producers)
+            producer.join();
+        return Result{
+            .time = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime),
+            .ordered = ordered,
+        };
+    }
+
+    void print(std::string const& name, std::uint32_t producerCount, std::uint32_t messagesPerProducer, Result result)
+    {
+        const auto messages = static_cast<double>(producerCount) * messagesPerProducer;
+        const auto seconds = static_cast<double>(std::max<std::int64_t>(result.time.count(), 1)) / 1'000'000.0;
+        std::cout << std::left << std::setw(10) << name << std::right << std::setw(10) << producerCount
+                  << std::setw(12) << result.time.count() << std::setw(16) << std::fixed << std::setprecision(2)
+                  << messages / seconds / 1'000'000.0 << (result.ordered ? "" : "  OUT OF ORDER") << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Nui::Benchmarks;
+
+    std::uint32_t messagesPerProducer = 200'000;
+    if (argc == 3 && std::string{argv[1]} == "--messages")
+        messagesPerProducer = static_cast<std::uint32_t>(std::stoul(argv[2]));
+    else if (argc != 1)
+    {
+        std::cerr << "usage: " << argv[0] << " [--messages <per producer>]\n";
+        return 2;
+    }
+
+    std::cout << std::left << std::setw(10) << "queue" << std::right << std::setw(10) << "producers" << std::setw(12)
+              << "time [us]" << std::setw(16) << "M messages/s" << std::endl;
+
+    bool success = true;
+    for (std::uint32_t producerCount : {1u, 2u, 4u, 8u})
+    {
+        const auto lockFree = run<Nui::MpscQueue<Message>>(producerCount, messagesPerProducer);
+        print("mpsc", producerCount, messagesPerProducer, lockFree);
+        const auto locked = run<LockedQueue>(producerCount, messagesPerProducer);
+        print("mutex", producerCount, messagesPerProducer, locked);
+        success = success && lockFree.ordered && locked.ordered;
+    }
+    return success ? 0 : 1;
+}
@@ -52,8 +52,8 @@ namespace Nui::Tests
         render(select);
 
         ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 2);
-        EXPECT_FALSE(Nui::val::global("document")["body"]["children"][0]["attributes"].hasOwnProperty("selected"));
-        EXPECT_TRUE(Nui::val::global("document")["body"]["children"][1]["attributes"].hasOwnProperty("selected"));
+        EXPECT_FALSE(Nui::val::global("document")["body"]["children"][0]["selected"].as<bool>());
+        EXPECT_TRUE(Nui::val::global("document")["body"]["children"][1]["selected"].as<bool>());
     }
 
     TEST_F(TestSelect, SelectAttributesAreForwarded)
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "../common_test_fixture.hpp"
+
+#include <nui/frontend/elements.hpp>
+#include <nui/frontend/attributes.hpp>
+#include <nui/frontend/components/text_input.hpp>
+#include <nui/frontend/dom/element.hpp>
+
+#include <string>
+
+namespace Nui::Tests
+{
+    using namespace Engine;
+
+    class TestTextInput : public CommonTestFixture
+    {
+      protected:
+        Observed<std::string> model_{"hello"};
+    };
+
+    TEST_F(TestTextInput, ValueIsSetAsProperty)
+    {
+        render(Components::TextInput(model_)());
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["value"].as<std::string>(), "hello");
+        EXPECT_FALSE(Nui::val::global("document")["body"]["attributes"].hasOwnProperty("value"));
+    }
+
+    TEST_F(TestTextInput, ModelChangesUpdateValueProperty)
+    {
+        render(Components::TextInput(model_)());
+
+        model_ = "world";
+        globalEventContext.executeActiveEventsImmediately();
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["value"].as<std::string>(), "world");
+    }
+
+    TEST_F(TestTextInput, InputUpdatesModel)
+    {
+        render(Components::TextInput(model_)());
+
+        Nui::val::global("document")["body"].set("value", Nui::val{"typed"});
+        Nui::val event = Nui::val::object();
+        event.set("target", Nui::val::global("document")["body"]);
+        Nui::val::global("document")["body"]["oninput"](event);
+
+        EXPECT_EQ(model_.value(), "typed");
+        EXPECT_EQ(Nui::val::global("document")["body"]["value"].as<std::string>(), "typed");
+    }
+}
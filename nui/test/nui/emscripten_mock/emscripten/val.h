@@ -8,6 +8,7 @@
 #include "../../engine/warn.hpp"
 #include "../../engine/reference_type.hpp"
 
+#include <cstddef>
 #include <utility>
 #include <type_traits>
 #include <vector>
@@ -19,6 +20,19 @@
 
 namespace emscripten
 {
+    template <typename T>
+    struct memory_view
+    {
+        std::size_t size;
+        T const* data;
+    };
+
+    template <typename T>
+    memory_view<T> typed_memory_view(std::size_t size, T const* data)
+    {
+        return {size, data};
+    }
+
     class val
     {
       public:
@@ -60,6 +74,15 @@ namespace emscripten
             : referenced_value_{std::make_shared<Nui::Tests::Engine::ReferenceType>(
                   Nui::Tests::Engine::createValue(std::string{value}))}
         {}
+        // Typed arrays are plain arrays of numbers in the engine, so the view is copied.
+        template <typename T>
+        val(memory_view<T> view)
+            : val{array()}
+        {
+            for (std::size_t i = 0; i != view.size; ++i)
+                as<Nui::Tests::Engine::Array&>().push_back(std::make_shared<Nui::Tests::Engine::ReferenceType>(
+                    Nui::Tests::Engine::createValue(static_cast<int>(view.data[i]))));
+        }
         val(val const& other)
             : referenced_value_{other.referenced_value_}
         {}
@@ -87,6 +110,8 @@ namespace emscripten
         {
             if constexpr (std::is_same_v<T, val>)
                 return *this;
+            else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+                return Nui::Tests::Engine::allValues[*referenced_value_].template asNumber<T>();
             else
                 return Nui::Tests::Engine::allValues[*referenced_value_].template as<T const&>();
         }
@@ -96,6 +121,8 @@ namespace emscripten
         {
             if constexpr (std::is_same_v<T, val>)
                 return *this;
+            else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+                return Nui::Tests::Engine::allValues[*referenced_value_].template asNumber<T>();
             else
                 return withValueDo([](auto& value) -> decltype(auto) {
                     return value.template as<T&>();
@@ -109,7 +136,7 @@ namespace emscripten
                 return *this;
             else
                 return withValueDo([](auto&& value) -> T {
-                    return value.template as<T>();
+                    return std::move(value).template as<T>();
                 });
         }
 
@@ -144,6 +171,8 @@ namespace emscripten
             auto fn = [key](Nui::Tests::Engine::Value const& value) {
                 if (value.type() == Nui::Tests::Engine::Value::Type::Object)
                     return value.template as<Nui::Tests::Engine::Object const&>().reference(key);
+                else if (value.type() == Nui::Tests::Engine::Value::Type::Array)
+                    return value.template as<Nui::Tests::Engine::Array const&>().asObject().reference(key);
                 else
                     throw std::runtime_error{"val::operator[]: value is not an object"};
             };
@@ -179,7 +208,7 @@ namespace emscripten
         val operator[](val other)
         {
             if (other.isString())
-                return (*this)[other.as<std::string>()];
+                return (*this)[other.as<std::string>().c_str()];
             else if (other.isNumber())
                 return (*this)[other.as<int>()];
             else
@@ -189,7 +218,7 @@ namespace emscripten
         val operator[](val other) const
         {
             if (other.isString())
-                return (*this)[other.as<std::string>()];
+                return (*this)[other.as<std::string>().c_str()];
             else if (other.isNumber())
                 return (*this)[other.as<int>()];
             else
@@ -332,19 +361,18 @@ namespace emscripten
 #ifdef NUI_TEST_DEBUG_PRINT
             std::cout << "val::new_()\n";
 #endif
-            return withValueDo([... args = std::forward<List>(args)](auto& value) {
+            return withValueDo([... args = std::forward<List>(args)](auto& value) -> val {
                 if (value.type() == Nui::Tests::Engine::Value::Type::Object)
                 {
                     auto& obj = value.template as<Nui::Tests::Engine::Object&>();
                     if (obj.has("constructor"))
                     {
-                        return obj["constructor"].template as<Nui::Tests::Engine::Function&>()(
-                            std::forward<List>(args)...);
+                        return obj["constructor"].template as<Nui::Tests::Engine::Function&>()(args...);
                     }
                     else
                     {
                         Nui::Tests::Engine::warn("val::new_: object has no constructor");
-                        return Nui::Tests::Engine::Object{};
+                        return val::object();
                     }
                 }
                 else
@@ -406,6 +434,15 @@ namespace emscripten
             });
         }
 
+        bool strictlyEquals(val const& other) const
+        {
+            return withValueDo([&other](auto const& value) {
+                return other.withValueDo([&value](auto const& otherValue) {
+                    return value.strictlyEquals(otherValue);
+                });
+            });
+        }
+
         bool isNull() const
         {
             return withValueDo([](auto& value) {
@@ -479,7 +516,12 @@ namespace emscripten
                 std::vector<T> result;
                 result.reserve(array.size());
                 for (auto& item : array)
-                    result.push_back(Nui::Tests::Engine::allValues[*item].template as<T>());
+                {
+                    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+                        result.push_back(Nui::Tests::Engine::allValues[*item].template asNumber<T>());
+                    else
+                        result.push_back(Nui::Tests::Engine::allValues[*item].template as<T>());
+                }
                 return result;
             }
             else
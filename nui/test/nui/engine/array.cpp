@@ -8,7 +8,9 @@ namespace Nui::Tests::Engine
     Array::Array()
         : values_{}
         , arrayObject_{}
-    {}
+    {
+        updateArrayObject();
+    }
     Array::Array(const Array&) = default;
     Array::Array(Array&&) = default;
     Array& Array::operator=(const Array&) = default;
@@ -69,6 +71,13 @@ namespace Nui::Tests::Engine
         return values_.back();
     }
 
+    std::shared_ptr<ReferenceType> Array::insert(std::size_t index, std::shared_ptr<ReferenceType> const& reference)
+    {
+        auto it = values_.insert(values_.begin() + static_cast<std::ptrdiff_t>(index), reference);
+        updateArrayObject();
+        return *it;
+    }
+
     void Array::clearUndefinedAndNull()
     {
         values_.erase(
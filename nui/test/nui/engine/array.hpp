@@ -34,6 +34,7 @@ namespace Nui::Tests::Engine
 
         std::shared_ptr<ReferenceType> push_back(Value const& value);
         std::shared_ptr<ReferenceType> push_back(std::shared_ptr<ReferenceType> const& reference);
+        std::shared_ptr<ReferenceType> insert(std::size_t index, std::shared_ptr<ReferenceType> const& reference);
 
         void clearUndefinedAndNull();
 
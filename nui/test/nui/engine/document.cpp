@@ -7,11 +7,20 @@
 #include "global_object.hpp"
 
 #include <iostream>
+#include <map>
+#include <optional>
 
 namespace Nui::Tests::Engine
 {
     namespace
     {
+        std::map<std::string, std::size_t> domCalls;
+
+        void countDomCall(char const* name)
+        {
+            ++domCalls[name];
+        }
+
         // inefficient but simple
         void cleanUndefinedDom(Nui::val v)
         {
@@ -29,16 +38,63 @@ namespace Nui::Tests::Engine
             auto elem = Nui::val::object();
             elem.set("tagName", tag.template as<std::string>());
             elem.set("children", Nui::val::array());
+            // Live form properties, as found on input, option and friends.
+            elem.set("value", Nui::val{""});
+            elem.set("checked", Nui::val{false});
+            elem.set("selected", Nui::val{false});
+            elem.set("textContent", Nui::val{""});
             elem.set("appendChild", Function{[self = elem](Nui::val value) -> Nui::val {
+                         countDomCall("appendChild");
                          value.set("parentNode", self);
                          return self["children"].template as<Array&>().push_back(value.handle());
                      }});
+            elem.set("insertBefore", Function{[self = elem](Nui::val value, Nui::val reference) -> Nui::val {
+                         countDomCall("insertBefore");
+                         value.set("parentNode", self);
+                         auto& children = self["children"].template as<Array&>();
+                         auto it = std::find_if(children.begin(), children.end(), [&reference](auto const& child) {
+                             return *child == *reference.handle();
+                         });
+                         if (it == children.end())
+                             return children.push_back(value.handle());
+                         return children.insert(static_cast<std::size_t>(it - children.begin()), value.handle());
+                     }});
             elem.set("replaceWith", Function{[self = elem](Nui::val value) mutable -> Nui::val {
+                         countDomCall("replaceWith");
+                         // A node that is already in the tree is moved, so it must leave its previous position.
+                         if (value.hasOwnProperty("parentNode") && value["parentNode"].hasOwnProperty("children"))
+                         {
+                             auto& siblings = value["parentNode"]["children"].template as<Array&>();
+                             for (auto it = siblings.begin(); it != siblings.end(); ++it)
+                             {
+                                 if (**it == *value.handle() && *it != self.handle())
+                                 {
+                                     siblings.erase(it);
+                                     break;
+                                 }
+                             }
+                         }
+                         std::optional<Nui::val> parent;
+                         if (self.hasOwnProperty("parentNode"))
+                             parent = self["parentNode"];
                          *self.handle() = *value.handle();
+                         if (parent)
+                             self.set("parentNode", *parent);
                          return self;
                      }});
             elem.set("remove", Function{[self = elem]() -> Nui::val {
+                         countDomCall("remove");
+                         std::optional<Nui::val> parent;
+                         if (self.hasOwnProperty("parentNode"))
+                             parent = self["parentNode"];
                          allValues[*self.handle()] = nullptr;
+                         // Only the parent can hold the removed node, when it is known.
+                         if (parent && !parent->isNull() && !parent->isUndefined() &&
+                             parent->hasOwnProperty("children"))
+                         {
+                             (*parent)["children"].template as<Array&>().clearUndefinedAndNull();
+                             return Nui::val::undefined();
+                         }
                          if (!globalObject.has("document"))
                              return Nui::val::undefined();
                          if (Nui::val::global("document").hasOwnProperty("body"))
@@ -46,6 +102,7 @@ namespace Nui::Tests::Engine
                          return Nui::val::undefined();
                      }});
             elem.set("setAttribute", Function{[self = elem](Nui::val name, Nui::val value) -> Nui::val {
+                         countDomCall("setAttribute");
                          if (!self.template as<Object&>().has("attributes"))
                              self.set("attributes", createValue(Object{}));
 
@@ -53,7 +110,28 @@ namespace Nui::Tests::Engine
 
                          return Nui::val::undefined();
                      }});
+            elem.set("getAttributeNames", Function{[self = elem]() -> Nui::val {
+                         countDomCall("getAttributeNames");
+                         auto names = Nui::val::array();
+                         if (self.template as<Object&>().has("attributes"))
+                         {
+                             for (auto const& [name, value] : self["attributes"].template as<Object&>())
+                                 names.template as<Array&>().push_back(
+                                     std::make_shared<ReferenceType>(createValue(std::string{name})));
+                         }
+                         return names;
+                     }});
+            elem.set("getAttribute", Function{[self = elem](Nui::val name) -> Nui::val {
+                         countDomCall("getAttribute");
+                         auto value = self["attributes"][name];
+                         if (value.isString())
+                             return value;
+                         if (value.isNumber())
+                             return Nui::val{std::to_string(std::move(value).template as<long long>())};
+                         return Nui::val{""};
+                     }});
             elem.set("removeAttribute", Function{[self = elem](Nui::val name) -> Nui::val {
+                         countDomCall("removeAttribute");
                          if (!self.template as<Object&>().has("attributes"))
                              return Nui::val::undefined();
 
@@ -61,9 +139,52 @@ namespace Nui::Tests::Engine
 
                          return Nui::val::undefined();
                      }});
+            auto style = Nui::val::object();
+            style.set("setProperty", Function{[style](Nui::val name, Nui::val value) -> Nui::val {
+                          countDomCall("setProperty");
+                          style.set(name, value);
+                          return Nui::val::undefined();
+                      }});
+            style.set("removeProperty", Function{[style](Nui::val name) mutable -> Nui::val {
+                          countDomCall("removeProperty");
+                          style.delete_(name.template as<std::string>());
+                          return Nui::val::undefined();
+                      }});
+            elem.set("style", style);
+            auto classList = Nui::val::object();
+            classList.set("toggle", Function{[classList](Nui::val name, Nui::val force) mutable -> Nui::val {
+                              countDomCall("toggle");
+                              if (force.template as<bool>())
+                                  classList.set(name, Nui::val{true});
+                              else if (classList.hasOwnProperty(name.template as<std::string>().c_str()))
+                                  classList.delete_(name.template as<std::string>());
+                              return force;
+                          }});
+            elem.set("classList", classList);
+            elem.set("insertAdjacentHTML", Function{[self = elem](Nui::val position, Nui::val html) mutable -> Nui::val {
+                         countDomCall("insertAdjacentHTML");
+                         // No actual parsing, the node only knows its tag and the html it was created from.
+                         const auto text = html.template as<std::string>();
+                         auto node = createElement(Nui::val{text.substr(1, text.find_first_of(" >") - 1)});
+                         node.set("outerHTML", Nui::val{text});
+                         const auto where = position.template as<std::string>();
+                         if (where == "beforeend")
+                         {
+                             self.call<Nui::val>("appendChild", node);
+                             self.set("lastElementChild", node);
+                         }
+                         else if (where == "afterend")
+                             self.set("nextElementSibling", node);
+                         else if (where == "beforebegin")
+                             self.set("previousElementSibling", node);
+                         return Nui::val::undefined();
+                     }});
             elem.set("removeChild", Function{[self = elem](Nui::val value) -> Nui::val {
+                         countDomCall("removeChild");
                          auto& children = self["children"].template as<Array&>();
-                         auto it = std::find(children.begin(), children.end(), value.handle());
+                         auto it = std::find_if(children.begin(), children.end(), [&value](auto const& child) {
+                             return *child == *value.handle();
+                         });
                          if (it != children.end())
                              children.erase(it);
                          return Nui::val::undefined();
@@ -75,7 +196,10 @@ namespace Nui::Tests::Engine
     Document::Document()
     {
         globalObject.emplace("document", Object{});
-        Nui::val::global("document").set("createElement", createElement);
+        Nui::val::global("document").set("createElement", Function{[](Nui::val tag) -> Nui::val {
+                                              countDomCall("createElement");
+                                              return createElement(tag);
+                                          }});
         Nui::val::global("document").set("body", createElement("body"));
     }
 
@@ -83,4 +207,9 @@ namespace Nui::Tests::Engine
     {
         return Nui::val::global("document");
     }
-}
\ No newline at end of file
+
+    std::map<std::string, std::size_t>& domCallCounts()
+    {
+        return domCalls;
+    }
+}
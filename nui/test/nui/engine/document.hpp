@@ -2,6 +2,10 @@
 
 #include <nui/frontend/val.hpp>
 
+#include <cstddef>
+#include <map>
+#include <string>
+
 namespace Nui::Tests::Engine
 {
     class Document
@@ -11,4 +15,7 @@ namespace Nui::Tests::Engine
 
         Nui::val document();
     };
+
+    /// Number of calls per mock DOM function (like "appendChild"), used by the benchmarks. Never reset implicitly.
+    std::map<std::string, std::size_t>& domCallCounts();
 }
\ No newline at end of file
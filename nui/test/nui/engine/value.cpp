@@ -24,6 +24,33 @@ namespace Nui::Tests::Engine
         , isInteger_{false}
     {}
 
+    bool Value::strictlyEquals(Value const& other) const
+    {
+        if (type_ != other.type_)
+            return false;
+
+        auto toNumber = [](Value const& value) -> long double {
+            if (value.isInteger_)
+                return static_cast<long double>(std::any_cast<long long>(value.value_));
+            return std::any_cast<long double>(value.value_);
+        };
+
+        switch (type_)
+        {
+            case Type::Undefined:
+            case Type::Null:
+                return true;
+            case Type::Boolean:
+                return std::any_cast<bool>(value_) == std::any_cast<bool>(other.value_);
+            case Type::Number:
+                return toNumber(*this) == toNumber(other);
+            case Type::String:
+                return std::any_cast<std::string const&>(value_) == std::any_cast<std::string const&>(other.value_);
+            default:
+                return instanceCounter_ == other.instanceCounter_;
+        }
+    }
+
     Value& Value::operator=(Object const& value)
     {
         type_ = Type::Object;
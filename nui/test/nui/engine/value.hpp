@@ -138,6 +138,14 @@ namespace Nui::Tests::Engine
         {
             return std::any_cast<T&>(value_);
         }
+        /// Converts like javascript numbers do, regardless of whether the number is stored as integer.
+        template <typename T>
+        T asNumber() const
+        {
+            if (isInteger_)
+                return static_cast<T>(std::any_cast<long long>(value_));
+            return static_cast<T>(std::any_cast<long double>(value_));
+        }
         template <typename T>
         T const& as() const&
         {
@@ -149,7 +157,7 @@ namespace Nui::Tests::Engine
             if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>)
             {
                 if (isInteger_ && type_ == Type::Number)
-                    return std::any_cast<T>(std::any_cast<long long>(value_));
+                    return static_cast<T>(std::any_cast<long long>(value_));
             }
             return std::any_cast<T>(value_);
         }
@@ -187,6 +195,9 @@ namespace Nui::Tests::Engine
 
         void print(int indent = 0, std::vector<ReferenceType> referenceStack = {}) const;
 
+        /// Behaves like the javascript === operator.
+        bool strictlyEquals(Value const& other) const;
+
         ReferenceType instanceCounter() const
         {
             return instanceCounter_;
@@ -9,6 +9,8 @@
 
 #include <nui/frontend/elements.hpp>
 #include <nui/frontend/attributes.hpp>
+#include <nui/frontend/attributes/impl/property_factory.hpp>
+#include <nui/frontend/event_system/event_delegation.hpp>
 
 namespace Nui::Tests
 {
@@ -358,6 +360,97 @@ namespace Nui::Tests
             "color:green;background-color:yellow");
     }
 
+    TEST_F(TestAttributes, StylePropertyBindingOnlyTouchesChangedProperties)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::style;
+
+        Observed<std::string> width{"10px"};
+        Observed<std::string> height{"20px"};
+        render(div{style["width"] = width, style["height"] = height, style["color"] = "red"}());
+
+        auto body = Nui::val::global("document")["body"];
+        EXPECT_EQ(body["style"]["width"].as<std::string>(), "10px");
+        EXPECT_EQ(body["style"]["height"].as<std::string>(), "20px");
+        EXPECT_EQ(body["style"]["color"].as<std::string>(), "red");
+        EXPECT_FALSE(body.hasOwnProperty("attributes"));
+
+        std::vector<std::string> touched;
+        body["style"].set("setProperty", Function{[&touched](Nui::val name, Nui::val) -> Nui::val {
+                              touched.push_back(name.as<std::string>());
+                              return Nui::val::undefined();
+                          }});
+        width = "50px";
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(touched, std::vector<std::string>{"width"});
+    }
+
+    TEST_F(TestAttributes, StylePropertyBindingCanUseGeneratorAndRemovesEmptyValues)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::style;
+
+        Observed<int> progress{10};
+        render(div{style["width"] = observe(progress).generate([&progress]() {
+            return progress.value() == 0 ? std::string{} : std::to_string(progress.value()) + "%";
+        })}());
+
+        auto body = Nui::val::global("document")["body"];
+        EXPECT_EQ(body["style"]["width"].as<std::string>(), "10%");
+        progress = 0;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_FALSE(body["style"].hasOwnProperty("width"));
+    }
+
+    TEST_F(TestAttributes, ClassListTogglesOnlyChangedClasses)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::classList;
+
+        Observed<bool> active{true};
+        Observed<bool> disabled{false};
+        Observed<int> count{0};
+        render(div{
+            classList["active"] = active,
+            classList["disabled"] = disabled,
+            classList["static"] = true,
+            classList["many"] = observe(count).generate([&count]() {
+                return count.value() > 5;
+            })}());
+
+        auto body = Nui::val::global("document")["body"];
+        EXPECT_TRUE(body["classList"].hasOwnProperty("active"));
+        EXPECT_FALSE(body["classList"].hasOwnProperty("disabled"));
+        EXPECT_TRUE(body["classList"].hasOwnProperty("static"));
+        EXPECT_FALSE(body["classList"].hasOwnProperty("many"));
+
+        std::vector<std::string> toggled;
+        body["classList"].set("toggle", Function{[&toggled](Nui::val name, Nui::val force) -> Nui::val {
+                                  toggled.push_back(name.as<std::string>());
+                                  return force;
+                              }});
+        active = false;
+        count = 10;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(toggled, (std::vector<std::string>{"active", "many"}));
+    }
+
+    TEST_F(TestAttributes, PropertyBindingSetsLiveProperty)
+    {
+        using Nui::Elements::input;
+        using namespace Nui::Attributes::Literals;
+
+        Observed<bool> checked{true};
+        render(input{"checked"_prop = checked}());
+
+        EXPECT_TRUE(Nui::val::global("document")["body"]["checked"].as<bool>());
+        EXPECT_FALSE(Nui::val::global("document")["body"].hasOwnProperty("attributes"));
+
+        checked = false;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_FALSE(Nui::val::global("document")["body"]["checked"].as<bool>());
+    }
+
     TEST_F(TestAttributes, EventIsCallable)
     {
         using Nui::Elements::div;
@@ -474,4 +567,330 @@ namespace Nui::Tests
         globalEventContext.executeActiveEventsImmediately();
         EXPECT_EQ(Nui::val::global("document")["body"]["attributes"]["id"].as<std::string>(), "B");
     }
-}
\ No newline at end of file
+
+    TEST_F(TestAttributes, ClonedElementSharesAttributeList)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::class_;
+        using Nui::Attributes::id;
+
+        div element{class_ = "asdf", id = "qwer"};
+        const auto clone = element.clone();
+
+        EXPECT_EQ(&element.attributes(), &clone.attributes());
+        EXPECT_EQ(clone.attributes().size(), 2);
+        EXPECT_EQ(div{}.sharedAttributes(), div{}.sharedAttributes());
+    }
+
+    TEST_F(TestAttributes, AttributeRepresentationMatchesKind)
+    {
+        using Nui::Attributes::class_;
+        using Nui::Attributes::id;
+        using Nui::Attributes::onClick;
+
+        Observed<std::string> observedClass{"asdf"};
+        Observed<int> number{0};
+
+        const Attribute staticAttribute = class_ = "asdf";
+        const Attribute observedAttribute = class_ = observedClass;
+        const Attribute combinatorAttribute = id = observe(number).generate([&number]() {
+            return std::to_string(number.value());
+        });
+        const Attribute eventAttribute = onClick = []() {};
+
+        EXPECT_TRUE(std::holds_alternative<Attribute::StaticValue>(staticAttribute.representation()));
+        EXPECT_TRUE(std::holds_alternative<Attribute::ObservedBinding>(observedAttribute.representation()));
+        EXPECT_TRUE(std::holds_alternative<Attribute::CombinatorBinding>(combinatorAttribute.representation()));
+        EXPECT_TRUE(std::holds_alternative<Attribute::EventHandler>(eventAttribute.representation()));
+        EXPECT_FALSE(staticAttribute.isDynamic());
+        EXPECT_TRUE(observedAttribute.isDynamic());
+    }
+
+    TEST_F(TestAttributes, ObservedAttributeEventIsDroppedAfterElementIsReplaced)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::class_;
+
+        Observed<std::string> observedClass{"asdf"};
+        Observed<bool> toggle{true};
+
+        render(div{}(observe(toggle), [&]() -> Nui::ElementRenderer {
+            if (toggle.value())
+                return span{class_ = observedClass}();
+            return span{}();
+        }));
+
+        EXPECT_EQ(observedClass.attachedEventCount(), 1);
+        toggle = false;
+        globalEventContext.executeActiveEventsImmediately();
+
+        // Events of destroyed elements are dropped on their next update.
+        observedClass = "qwer";
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(observedClass.attachedEventCount(), 0);
+    }
+
+    TEST_F(TestAttributes, DelegatedEventsShareOneDocumentListener)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::onClick;
+        using Nui::Attributes::reference;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        Nui::val::global("document")
+            .set("addEventListener", Function{[&listeners](Nui::val, Nui::val listener, Nui::val) -> Nui::val {
+                     listeners.push_back(listener);
+                     return Nui::val::undefined();
+                 }});
+
+        int outerClicks = 0;
+        int innerClicks = 0;
+        std::vector<Nui::val> references;
+        render(div{onClick.delegate([&outerClicks]() {
+            ++outerClicks;
+        })}(
+            span{
+                reference = accumulateReferences(references),
+                onClick.delegate([&innerClicks]() {
+                    ++innerClicks;
+                })}(),
+            span{onClick.delegate([&innerClicks]() {
+                ++innerClicks;
+            })}()));
+        dom_.root().val().set("parentNode", Nui::val::null());
+
+        ASSERT_EQ(listeners.size(), 1);
+        EXPECT_EQ(globalEventDelegation.elementCount(), 3);
+        EXPECT_FALSE(Nui::val::global("document")["body"].hasOwnProperty("onclick"));
+
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"click"});
+        event.set("bubbles", Nui::val{true});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", references[0]);
+        listeners[0](event);
+
+        EXPECT_EQ(innerClicks, 1);
+        EXPECT_EQ(outerClicks, 1);
+
+        event.set("bubbles", Nui::val{false});
+        listeners[0](event);
+
+        EXPECT_EQ(innerClicks, 2);
+        EXPECT_EQ(outerClicks, 1);
+    }
+
+    TEST_F(TestAttributes, DelegatedEventsAreCapturedAtTheDocument)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::onClick;
+        using Nui::Attributes::onFocus;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        std::vector<bool> captures;
+        Nui::val::global("document")
+            .set(
+                "addEventListener",
+                Function{[&listeners, &captures](Nui::val, Nui::val listener, Nui::val capture) -> Nui::val {
+                    listeners.push_back(listener);
+                    captures.push_back(capture.as<bool>());
+                    return Nui::val::undefined();
+                }});
+
+        std::optional<Nui::val> currentTarget;
+        std::optional<Nui::val> target;
+        int focused = 0;
+        render(div{
+            onClick.delegate([&currentTarget, &target](Nui::val event) {
+                currentTarget = event["currentTarget"];
+                target = event["target"];
+            }),
+            onFocus.delegate([&focused]() {
+                ++focused;
+            })}());
+        dom_.root().val().set("parentNode", Nui::val::null());
+        ASSERT_EQ(listeners.size(), 2);
+        EXPECT_EQ(captures, (std::vector<bool>{true, true}));
+
+        // The event is handed over as the browser dispatches it to the document listener.
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"click"});
+        event.set("bubbles", Nui::val{true});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", dom_.root().val());
+        event.set("currentTarget", Nui::val::global("document"));
+        listeners[0](event);
+
+        ASSERT_TRUE(currentTarget);
+        EXPECT_TRUE(currentTarget->strictlyEquals(Nui::val::global("document")));
+        ASSERT_TRUE(target);
+        EXPECT_TRUE(target->strictlyEquals(dom_.root().val()));
+
+        // Focus does not bubble, only the capture phase delivers it to the document.
+        event.set("type", Nui::val{"focus"});
+        event.set("bubbles", Nui::val{false});
+        listeners[1](event);
+        EXPECT_EQ(focused, 1);
+    }
+
+    TEST_F(TestAttributes, StopPropagationInDelegatedHandlerStopsTheNativeEvent)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::onClick;
+        using Nui::Attributes::reference;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        Nui::val::global("document")
+            .set("addEventListener", Function{[&listeners](Nui::val, Nui::val listener, Nui::val) -> Nui::val {
+                     listeners.push_back(listener);
+                     return Nui::val::undefined();
+                 }});
+
+        int outerClicks = 0;
+        int innerClicks = 0;
+        std::vector<Nui::val> references;
+        render(div{onClick.delegate([&outerClicks]() {
+            ++outerClicks;
+        })}(span{
+            reference = accumulateReferences(references),
+            onClick.delegate([&innerClicks](Nui::val event) {
+                ++innerClicks;
+                event.call<void>("stopPropagation");
+            })}()));
+        dom_.root().val().set("parentNode", Nui::val::null());
+        ASSERT_EQ(listeners.size(), 1);
+
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"click"});
+        event.set("bubbles", Nui::val{true});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", references[0]);
+        event.set("stopPropagation", Function{[event]() mutable -> Nui::val {
+                      event.set("cancelBubble", Nui::val{true});
+                      return Nui::val::undefined();
+                  }});
+        listeners[0](event);
+
+        EXPECT_EQ(innerClicks, 1);
+        EXPECT_EQ(outerClicks, 0);
+        // The browser would not deliver this event to any listener on the span or the div.
+        EXPECT_TRUE(event["cancelBubble"].as<bool>());
+    }
+
+    TEST_F(TestAttributes, DelegatedEventsOfReleasedNodesDoNotReachReusedSlots)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::onClick;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        Nui::val::global("document")
+            .set("addEventListener", Function{[&listeners](Nui::val, Nui::val listener, Nui::val) -> Nui::val {
+                     listeners.push_back(listener);
+                     return Nui::val::undefined();
+                 }});
+
+        int clicks = 0;
+        render(div{onClick.delegate([&clicks]() {
+            ++clicks;
+        })}());
+        dom_.root().val().set("parentNode", Nui::val::null());
+        ASSERT_EQ(listeners.size(), 1);
+        const auto id = dom_.root().val()[EventDelegation::idProperty];
+
+        // A node whose element is gone still carries the id of its former slot, which now belongs to the div.
+        auto staleNode = Nui::val::object();
+        staleNode.set(EventDelegation::idProperty, id);
+        staleNode.set("parentNode", Nui::val::null());
+
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"click"});
+        event.set("bubbles", Nui::val{true});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", staleNode);
+        listeners[0](event);
+        EXPECT_EQ(clicks, 0);
+
+        event.set("target", dom_.root().val());
+        listeners[0](event);
+        EXPECT_EQ(clicks, 1);
+    }
+
+    TEST_F(TestAttributes, DelegatedHandlersAreNotDuplicatedWhenElementIsSetUpAgain)
+    {
+        using Nui::Elements::body;
+        using Nui::Attributes::onClick;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        Nui::val::global("document")
+            .set("addEventListener", Function{[&listeners](Nui::val, Nui::val listener, Nui::val) -> Nui::val {
+                     listeners.push_back(listener);
+                     return Nui::val::undefined();
+                 }});
+
+        int firstClicks = 0;
+        int secondClicks = 0;
+        dom_.setBody(body{onClick.delegate([&firstClicks]() {
+            ++firstClicks;
+        })}());
+        // Adopts the same node and sets it up again.
+        dom_.hydrateBody(body{onClick.delegate([&secondClicks]() {
+            ++secondClicks;
+        })}());
+        EXPECT_EQ(globalEventDelegation.elementCount(), 1);
+
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"click"});
+        event.set("bubbles", Nui::val{false});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", dom_.root().val());
+        ASSERT_EQ(listeners.size(), 1);
+        listeners[0](event);
+
+        EXPECT_EQ(firstClicks, 0);
+        EXPECT_EQ(secondClicks, 1);
+    }
+
+    TEST_F(TestAttributes, UnhandledDelegatedEventsDoNotRunPendingEvents)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::id;
+        using Nui::Attributes::onClick;
+
+        globalEventDelegation.reset();
+        std::vector<Nui::val> listeners;
+        Nui::val::global("document")
+            .set("addEventListener", Function{[&listeners](Nui::val, Nui::val listener, Nui::val) -> Nui::val {
+                     listeners.push_back(listener);
+                     return Nui::val::undefined();
+                 }});
+
+        Observed<std::string> idValue{"A"};
+        render(div{id = idValue, onClick.delegate([]() {})}());
+        dom_.root().val().set("parentNode", Nui::val::null());
+        ASSERT_EQ(listeners.size(), 1);
+
+        {
+            auto proxy = idValue.modify();
+            *proxy = "B";
+        }
+        auto event = Nui::val::object();
+        event.set("type", Nui::val{"mousedown"});
+        event.set("bubbles", Nui::val{true});
+        event.set("cancelBubble", Nui::val{false});
+        event.set("target", dom_.root().val());
+        listeners[0](event);
+        EXPECT_EQ(Nui::val::global("document")["body"]["attributes"]["id"].as<std::string>(), "A");
+
+        event.set("type", Nui::val{"click"});
+        listeners[0](event);
+        EXPECT_EQ(Nui::val::global("document")["body"]["attributes"]["id"].as<std::string>(), "B");
+    }
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "common_test_fixture.hpp"
+#include "engine/global_object.hpp"
+#include "engine/function.hpp"
+#include "engine/object.hpp"
+#include "engine/array.hpp"
+
+#include <nui/frontend/api/fetch.hpp>
+#include <nui/frontend/rpc_client.hpp>
+#include <nui/utility/base64.hpp>
+
+#include <optional>
+#include <string>
+
+namespace Nui::Tests
+{
+    using namespace Engine;
+
+    class TestFetch : public CommonTestFixture
+    {
+      protected:
+        TestFetch()
+        {
+            globalObject.emplace("nui_rpc", Object{});
+            Nui::val::global("nui_rpc").set("frontend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("backend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("tempId", 0);
+
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::fetch", Function{[this](Nui::val requestId, Nui::val url, Nui::val options) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    lastUrl_ = url.as<std::string>();
+                    lastOptions_ = options;
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::cancelFetch", Function{[this](Nui::val requestId) -> Nui::val {
+                    cancelledRequestId_ = requestId.as<long long>();
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::fetchCacheStatistics", Function{[this](Nui::val requestId) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    return Nui::val::undefined();
+                }});
+            // Used to convert the headers.
+            globalObject.emplace("Object", Object{});
+            Nui::val::global("Object").set("keys", Function{[](Nui::val object) -> Nui::val {
+                                               auto keys = Nui::val::array();
+                                               for (auto const& [key, value] : object.as<Object const&>())
+                                                   keys.as<Array&>().push_back(
+                                                       std::make_shared<ReferenceType>(createValue(std::string{key})));
+                                               return keys;
+                                           }});
+        }
+
+        void respond(std::string const& body, bool bodyIsBase64)
+        {
+            auto value = Nui::val::object();
+            value.set("curlCode", 0);
+            value.set("status", 200);
+            value.set("proxyStatus", 0);
+            value.set("downloadSize", static_cast<int>(body.size()));
+            value.set("redirectUrl", std::string{});
+            value.set("body", body);
+            value.set("headers", Nui::val::object());
+            value.set("bodyIsBase64", bodyIsBase64);
+            respondWith(value);
+        }
+
+        void respondWith(Nui::val value)
+        {
+            auto response = Nui::val::object();
+            response.set("id", *lastRequestId_);
+            response.set("value", value);
+            Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+        }
+
+      protected:
+        std::optional<long long> lastRequestId_{};
+        std::optional<std::string> lastUrl_{};
+        Nui::val lastOptions_{};
+        std::optional<long long> cancelledRequestId_{};
+    };
+
+    TEST_F(TestFetch, TextBodyIsPassedAsIs)
+    {
+        std::optional<FetchResponse> result;
+        const auto fetchId = fetch("http://localhost/data", [&result](std::optional<FetchResponse> const& response) {
+            result = response;
+        });
+
+        ASSERT_TRUE(lastRequestId_);
+        EXPECT_EQ(*lastRequestId_, fetchId);
+        EXPECT_EQ(lastUrl_, "http://localhost/data");
+
+        respond("{\"a\": 1}", false);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->status, 200);
+        EXPECT_EQ(result->body, "{\"a\": 1}");
+    }
+
+    TEST_F(TestFetch, Base64BodyIsDecoded)
+    {
+        std::optional<FetchResponse> result;
+        fetch("http://localhost/image", [&result](std::optional<FetchResponse> const& response) {
+            result = response;
+        });
+
+        const auto bytes = std::string{"\x00" "a\xff\x80\xc3", 5};
+        respond(base64Encode(bytes), true);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->body, bytes);
+    }
+
+    TEST_F(TestFetch, BinaryBodyBytesAreCopied)
+    {
+        std::optional<FetchResponse> result;
+        fetch("http://localhost/image", [&result](std::optional<FetchResponse> const& response) {
+            result = response;
+        });
+
+        auto bytes = Nui::val::array();
+        for (const auto byte : {0, 97, 255, 128})
+            bytes.as<Array&>().push_back(std::make_shared<ReferenceType>(createValue(byte)));
+        auto value = Nui::val::object();
+        value.set("curlCode", 0);
+        value.set("status", 200);
+        value.set("proxyStatus", 0);
+        value.set("downloadSize", 4);
+        value.set("redirectUrl", std::string{});
+        value.set("body", std::string{});
+        value.set("headers", Nui::val::object());
+        value.set("bodyIsBase64", false);
+        value.set("bodyBytes", bytes);
+        respondWith(value);
+
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->body, (std::string{"\x00" "a\xff\x80", 4}));
+    }
+
+    TEST_F(TestFetch, UndecodableBodyFailsTheResponse)
+    {
+        bool called = false;
+        std::optional<FetchResponse> result;
+        fetch("http://localhost/image", [&](std::optional<FetchResponse> const& response) {
+            called = true;
+            result = response;
+        });
+
+        respond("not base64!", true);
+        EXPECT_TRUE(called);
+        EXPECT_FALSE(result);
+    }
+
+    TEST_F(TestFetch, Base64HeadersAreDecoded)
+    {
+        std::optional<FetchResponse> result;
+        fetch("http://localhost/legacy", [&result](std::optional<FetchResponse> const& response) {
+            result = response;
+        });
+
+        auto headers = Nui::val::object();
+        headers.set(base64Encode("X-Raw"), base64Encode(std::string{"\x00\xff", 2}));
+        auto value = Nui::val::object();
+        value.set("curlCode", 0);
+        value.set("status", 200);
+        value.set("proxyStatus", 0);
+        value.set("downloadSize", 0);
+        value.set("redirectUrl", std::string{});
+        value.set("body", std::string{});
+        value.set("headers", headers);
+        value.set("bodyIsBase64", false);
+        value.set("headersAreBase64", true);
+        respondWith(value);
+
+        ASSERT_TRUE(result);
+        ASSERT_EQ(result->headers.size(), 1);
+        EXPECT_EQ(result->headers.at("X-Raw"), (std::string{"\x00\xff", 2}));
+    }
+
+    TEST_F(TestFetch, FailedResponseCallsBackWithoutResult)
+    {
+        bool called = false;
+        std::optional<FetchResponse> result;
+        fetch("http://localhost/broken", [&](std::optional<FetchResponse> const& response) {
+            called = true;
+            result = response;
+        });
+
+        auto response = Nui::val::object();
+        response.set("id", *lastRequestId_);
+        response.set("error", std::string{"invalid UTF-8 byte"});
+        Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+
+        EXPECT_TRUE(called);
+        EXPECT_FALSE(result);
+    }
+
+    TEST_F(TestFetch, CancelledFetchDoesNotCallBack)
+    {
+        bool called = false;
+        const auto fetchId = fetch("http://localhost/slow", [&called](std::optional<FetchResponse> const&) {
+            called = true;
+        });
+
+        cancelFetch(fetchId);
+        EXPECT_EQ(cancelledRequestId_, fetchId);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 0);
+
+        respond("late", false);
+        EXPECT_FALSE(called);
+    }
+
+    TEST_F(TestFetch, CacheOptionsArePassedToTheBackend)
+    {
+        fetch(
+            "http://localhost/schema",
+            FetchOptions{.cache = "no-cache", .cacheOnDisk = false},
+            [](std::optional<FetchResponse> const&) {});
+
+        ASSERT_TRUE(lastRequestId_);
+        EXPECT_EQ(lastOptions_["cache"].as<std::string>(), "no-cache");
+        EXPECT_FALSE(lastOptions_["cacheOnDisk"].as<bool>());
+    }
+
+    TEST_F(TestFetch, CacheStatisticsAreConverted)
+    {
+        std::optional<FetchCacheStatistics> result;
+        fetchCacheStatistics([&result](std::optional<FetchCacheStatistics> const& statistics) {
+            result = statistics;
+        });
+        ASSERT_TRUE(lastRequestId_);
+
+        auto value = Nui::val::object();
+        value.set("hits", 3);
+        value.set("revalidations", 1);
+        value.set("misses", 2);
+        value.set("evictions", 0);
+        value.set("memoryEntries", 2);
+        value.set("memoryBytes", 1024.0);
+        value.set("diskEntries", 0);
+        value.set("diskBytes", 0.0);
+        respondWith(value);
+
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->hits, 3);
+        EXPECT_EQ(result->revalidations, 1);
+        EXPECT_EQ(result->misses, 2);
+        EXPECT_EQ(result->memoryBytes, 1024.0);
+    }
+}
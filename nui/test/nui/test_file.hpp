@@ -0,0 +1,300 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "common_test_fixture.hpp"
+#include "engine/global_object.hpp"
+#include "engine/function.hpp"
+#include "engine/object.hpp"
+#include "engine/array.hpp"
+
+#include <nui/frontend/filesystem/file.hpp>
+#include <nui/frontend/rpc_client.hpp>
+#include <nui/utility/base64.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Nui::Tests
+{
+    using namespace Engine;
+
+    class TestFile : public CommonTestFixture
+    {
+      protected:
+        TestFile()
+        {
+            globalObject.emplace("nui_rpc", Object{});
+            Nui::val::global("nui_rpc").set("frontend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("backend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("tempId", 0);
+
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::openFile", Function{[this](Nui::val requestId, Nui::val, Nui::val) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::closeFile", Function{[this](Nui::val) -> Nui::val {
+                    ++closeCount_;
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::readChunk", Function{[this](Nui::val requestId, Nui::val, Nui::val maxSize) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    lastChunkSize_ = maxSize.as<long long>();
+                    ++chunkRequests_;
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::tellg", Function{[this](Nui::val requestId, Nui::val) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    return Nui::val::undefined();
+                }});
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Nui::write", Function{[this](Nui::val requestId, Nui::val, Nui::val data) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    if (data.typeOf().as<std::string>() == "string")
+                    {
+                        lastWritten_ = data.as<std::string>();
+                        writes_.push_back(base64Decode(*lastWritten_).value_or("<not base64>"));
+                    }
+                    else
+                    {
+                        const auto bytes = emscripten::convertJSArrayToNumberVector<std::uint8_t>(data);
+                        writes_.emplace_back(bytes.begin(), bytes.end());
+                        ++binaryWrites_;
+                    }
+                    return Nui::val::undefined();
+                }});
+        }
+
+        std::optional<AsyncFile> open()
+        {
+            std::optional<AsyncFile> file;
+            openFile("data.bin", std::ios_base::in, [&file](std::optional<AsyncFile>&& opened) {
+                file = std::move(opened);
+            });
+            auto value = Nui::val::object();
+            value.set("success", true);
+            value.set("id", 7);
+            respondWith(value);
+            return file;
+        }
+
+        void respondWithChunk(Nui::val data, bool end)
+        {
+            auto value = Nui::val::object();
+            value.set("data", data);
+            value.set("end", end);
+            respondWith(value);
+        }
+
+        void respondWith(Nui::val value)
+        {
+            auto response = Nui::val::object();
+            response.set("id", *lastRequestId_);
+            response.set("value", value);
+            Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+        }
+
+        void respondWithError(std::string const& message)
+        {
+            auto response = Nui::val::object();
+            response.set("id", *lastRequestId_);
+            response.set("error", message);
+            Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+        }
+
+        /// Makes the frontend believe that calls go over the binary rpc transport.
+        void enableBinaryTransport()
+        {
+            Nui::val::global("nui_rpc").set("sendBinary", Function{[](Nui::val, Nui::val) -> Nui::val {
+                                                return Nui::val::undefined();
+                                            }});
+        }
+
+      protected:
+        std::optional<long long> lastRequestId_{};
+        std::optional<long long> lastChunkSize_{};
+        std::optional<std::string> lastWritten_{};
+        std::vector<std::string> writes_{};
+        int binaryWrites_{0};
+        int chunkRequests_{0};
+        int closeCount_{0};
+    };
+
+    TEST_F(TestFile, FileIsClosedOnceWhenDestroyed)
+    {
+        {
+            auto file = open();
+            ASSERT_TRUE(file);
+            EXPECT_EQ(closeCount_, 0);
+        }
+        EXPECT_EQ(closeCount_, 1);
+    }
+
+    TEST_F(TestFile, ChunksArePulledOneAtATime)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        std::vector<std::string> chunks;
+        bool ended = false;
+        file->chunks(4).forEach(
+            [&chunks](std::string&& chunk) {
+                chunks.push_back(std::move(chunk));
+            },
+            [&ended]() {
+                ended = true;
+            });
+
+        EXPECT_EQ(chunkRequests_, 1);
+        EXPECT_EQ(lastChunkSize_, 4);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 1);
+
+        respondWithChunk(Nui::val{base64Encode("abcd")}, false);
+        EXPECT_EQ(chunkRequests_, 2);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 1);
+
+        respondWithChunk(Nui::val{base64Encode("ef")}, true);
+        EXPECT_EQ(chunkRequests_, 2);
+        EXPECT_TRUE(ended);
+        EXPECT_EQ(chunks, (std::vector<std::string>{"abcd", "ef"}));
+    }
+
+    TEST_F(TestFile, BinaryChunksAreDecoded)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        std::optional<std::string> result;
+        file->chunks().next([&result](std::optional<std::string>&& chunk) {
+            result = std::move(chunk);
+        });
+        EXPECT_EQ(lastChunkSize_, AsyncFile::defaultChunkSize);
+
+        auto bytes = Nui::val::array();
+        for (const auto byte : {0, 128, 255})
+            bytes.as<Array&>().push_back(std::make_shared<ReferenceType>(createValue(byte)));
+        respondWithChunk(bytes, true);
+
+        ASSERT_TRUE(result);
+        EXPECT_EQ(*result, (std::string{'\x00', '\x80', '\xff'}));
+    }
+
+    TEST_F(TestFile, EmptyLastChunkEndsIteration)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        auto chunks = file->chunks();
+        bool called = false;
+        std::optional<std::string> result;
+        chunks.next([&](std::optional<std::string>&& chunk) {
+            called = true;
+            result = std::move(chunk);
+        });
+        respondWithChunk(Nui::val{std::string{}}, true);
+
+        EXPECT_TRUE(called);
+        EXPECT_FALSE(result);
+        EXPECT_TRUE(chunks.done());
+    }
+
+    TEST_F(TestFile, PositionsBeyond32BitArePreserved)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        std::optional<std::int64_t> position;
+        file->tellg([&position](std::int64_t pos) {
+            position = pos;
+        });
+        respondWith(Nui::val{5'000'000'000.0});
+
+        EXPECT_EQ(position, 5'000'000'000);
+    }
+
+    TEST_F(TestFile, WrittenDataIsBase64Encoded)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        file->write(std::string{"hi\0\xff", 4}, []() {});
+        ASSERT_TRUE(lastWritten_);
+        EXPECT_EQ(*lastWritten_, "aGkA/w==");
+        EXPECT_EQ(base64Decode(*lastWritten_), (std::string{"hi\0\xff", 4}));
+    }
+
+    TEST_F(TestFile, WrittenDataIsBinaryOverTheBinaryTransport)
+    {
+        enableBinaryTransport();
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        file->write(std::string{"hi\0\xff", 4}, []() {});
+        EXPECT_EQ(binaryWrites_, 1);
+        EXPECT_FALSE(lastWritten_);
+        EXPECT_EQ(writes_, (std::vector<std::string>{std::string{"hi\0\xff", 4}}));
+    }
+
+    TEST_F(TestFile, WriterSendsOneChunkAtATime)
+    {
+        enableBinaryTransport();
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        auto writer = file->writer(4);
+        std::vector<bool> results;
+        writer.write(std::string{"\0bcdefgh\xff", 9}, [&results](bool success) {
+            results.push_back(success);
+        });
+        writer.write("jk", [&results](bool success) {
+            results.push_back(success);
+        });
+        EXPECT_EQ(writes_, (std::vector<std::string>{std::string{"\0bcd", 4}}));
+        EXPECT_EQ(writer.pending(), 11u);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 1);
+
+        respondWith(Nui::val::undefined());
+        respondWith(Nui::val::undefined());
+        EXPECT_TRUE(results.empty());
+        respondWith(Nui::val::undefined());
+        EXPECT_EQ(results, (std::vector<bool>{true}));
+        respondWith(Nui::val::undefined());
+
+        EXPECT_EQ(results, (std::vector<bool>{true, true}));
+        EXPECT_EQ(
+            writes_, (std::vector<std::string>{std::string{"\0bcd", 4}, "efgh", std::string{"\xff"}, "jk"}));
+        EXPECT_EQ(binaryWrites_, 4);
+        EXPECT_EQ(writer.pending(), 0u);
+        EXPECT_FALSE(writer.failed());
+    }
+
+    TEST_F(TestFile, WriterFailsEverythingQueuedAfterAnError)
+    {
+        auto file = open();
+        ASSERT_TRUE(file);
+
+        auto writer = file->writer(2);
+        std::vector<bool> results;
+        const auto record = [&results](bool success) {
+            results.push_back(success);
+        };
+        writer.write("abcd", record);
+        writer.write("ef", record);
+        EXPECT_EQ(writes_, (std::vector<std::string>{"ab"}));
+
+        respondWithError("disk full");
+        EXPECT_EQ(results, (std::vector<bool>{false, false}));
+        EXPECT_TRUE(writer.failed());
+        EXPECT_EQ(writer.pending(), 0u);
+
+        writer.write("gh", record);
+        EXPECT_EQ(results, (std::vector<bool>{false, false, false}));
+        EXPECT_EQ(writes_.size(), 1u);
+    }
+}
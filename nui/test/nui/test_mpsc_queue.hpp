@@ -0,0 +1,77 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <nui/data_structures/mpsc_queue.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Nui::Tests
+{
+    TEST(TestMpscQueue, PopOnEmptyQueueReturnsNothing)
+    {
+        MpscQueue<int> queue;
+        EXPECT_FALSE(queue.pop());
+    }
+
+    TEST(TestMpscQueue, ElementsArePoppedInPushOrder)
+    {
+        MpscQueue<std::string> queue;
+        queue.push("a");
+        queue.push("b");
+        ASSERT_EQ(queue.pop(), "a");
+        queue.push("c");
+        EXPECT_EQ(queue.pop(), "b");
+        EXPECT_EQ(queue.pop(), "c");
+        EXPECT_FALSE(queue.pop());
+
+        queue.push("d");
+        EXPECT_EQ(queue.pop(), "d");
+    }
+
+    TEST(TestMpscQueue, RemainingElementsAreDestroyedWithQueue)
+    {
+        auto element = std::make_shared<int>(0);
+        {
+            MpscQueue<std::shared_ptr<int>> queue;
+            queue.push(element);
+            queue.push(element);
+            EXPECT_EQ(element.use_count(), 3);
+        }
+        EXPECT_EQ(element.use_count(), 1);
+    }
+
+    TEST(TestMpscQueue, ConcurrentProducersKeepTheirOrder)
+    {
+        constexpr int producerCount = 4;
+        constexpr int perProducer = 10'000;
+
+        MpscQueue<std::pair<int, int>> queue;
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer != producerCount; ++producer)
+        {
+            producers.emplace_back([&queue, producer]() {
+                for (int i = 0; i != perProducer; ++i)
+                    queue.push({producer, i});
+            });
+        }
+
+        std::vector<int> expected(producerCount, 0);
+        int received = 0;
+        while (received != producerCount * perProducer)
+        {
+            received += static_cast<int>(queue.drain([&expected](std::pair<int, int>&& element) {
+                EXPECT_EQ(element.second, expected[element.first]);
+                expected[element.first] = element.second + 1;
+            }));
+        }
+        for (auto& producer : producers)
+            producer.join();
+
+        EXPECT_FALSE(queue.pop());
+        EXPECT_EQ(expected, std::vector<int>(producerCount, perProducer));
+    }
+}
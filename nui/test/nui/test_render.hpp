@@ -9,17 +9,97 @@
 #include <nui/frontend/elements.hpp>
 #include <nui/frontend/attributes.hpp>
 #include <nui/frontend/dom/reference.hpp>
+#include <nui/frontend/utility/async_render.hpp>
 #include <nui/frontend/utility/stabilize.hpp>
+#include <nui/frontend/utility/static_html.hpp>
+#include <nui/frontend/utility/lazy.hpp>
+#include <nui/frontend/utility/memo.hpp>
+#include <nui/frontend/utility/prerender.hpp>
 
+#include <algorithm>
+#include <optional>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace Nui::Tests
 {
     using namespace Engine;
 
     class TestRender : public CommonTestFixture
-    {};
+    {
+      protected:
+        /**
+         * @brief Builds the DOM for the subset of html that renderToHtml writes: elements with quoted attributes and
+         * text. Every created element is marked, so that adopted ones can be told apart.
+         */
+        static void appendMarkup(Nui::val parent, std::string_view& html)
+        {
+            auto document = Nui::val::global("document");
+            while (!html.empty() && !html.starts_with("</"))
+            {
+                if (html.front() != '<')
+                {
+                    const auto end = std::min(html.find('<'), html.size());
+                    parent.set("textContent", Nui::val{unescape(html.substr(0, end))});
+                    html.remove_prefix(end);
+                    continue;
+                }
+
+                const auto tagEnd = html.find_first_of(" >");
+                const auto tag = std::string{html.substr(1, tagEnd - 1)};
+                html.remove_prefix(tagEnd);
+                auto element = document.call<Nui::val>("createElement", Nui::val{tag});
+                element.set("marker", Nui::val{true});
+                while (html.front() == ' ')
+                {
+                    const auto equals = html.find('=');
+                    const auto valueEnd = html.find('"', equals + 2);
+                    element.call<void>(
+                        "setAttribute",
+                        Nui::val{std::string{html.substr(1, equals - 1)}},
+                        Nui::val{unescape(html.substr(equals + 2, valueEnd - equals - 2))});
+                    html.remove_prefix(valueEnd + 1);
+                }
+                html.remove_prefix(1);
+
+                if (tag != "input")
+                {
+                    appendMarkup(element, html);
+                    html.remove_prefix(html.find('>') + 1);
+                }
+                parent.call<void>("appendChild", element);
+            }
+        }
+
+      private:
+        static std::string unescape(std::string_view text)
+        {
+            std::string result;
+            while (!text.empty())
+            {
+                bool replaced = false;
+                for (auto const& [entity, character] :
+                     {std::pair{"&lt;", '<'}, std::pair{"&gt;", '>'}, std::pair{"&quot;", '"'}, std::pair{"&amp;", '&'}})
+                {
+                    if (text.starts_with(entity))
+                    {
+                        result += character;
+                        text.remove_prefix(std::string_view{entity}.size());
+                        replaced = true;
+                        break;
+                    }
+                }
+                if (!replaced)
+                {
+                    result += text.front();
+                    text.remove_prefix(1);
+                }
+            }
+            return result;
+        }
+    };
 
     TEST_F(TestRender, CanRenderBasicDiv)
     {
@@ -519,4 +599,595 @@ namespace Nui::Tests
             Nui::val::global("document")["body"]["children"][0]["children"][0]["attributes"]["class"].as<std::string>(),
             "Y");
     }
-}
\ No newline at end of file
+
+    TEST_F(TestRender, LazyRendersImmediatelyWithoutBrowserSupport)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        globalObject.emplace("window", Object{});
+        render(div{}(lazy(span{}("content"))));
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "span");
+    }
+
+    TEST_F(TestRender, LazyRendersWhenIdle)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        std::vector<Nui::val> idleCallbacks;
+        globalObject.emplace("window", Object{});
+        Nui::val::global("window").set("requestIdleCallback", Function{[&idleCallbacks](Nui::val callback) -> Nui::val {
+                                           idleCallbacks.push_back(callback);
+                                           return Nui::val{1};
+                                       }});
+        Nui::val::global("window").set("cancelIdleCallback", Function{[](Nui::val) -> Nui::val {
+                                           return Nui::val::undefined();
+                                       }});
+
+        render(div{}(lazy(span{}("content"))));
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "div");
+        ASSERT_EQ(idleCallbacks.size(), 1);
+
+        idleCallbacks[0](Nui::val::object());
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "span");
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "content");
+    }
+
+    TEST_F(TestRender, LazyRendersWhenVisible)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        std::vector<Nui::val> observerCallbacks;
+        int observed = 0;
+        bool disconnected = false;
+        Object intersectionObserver;
+        intersectionObserver["constructor"] = Function{[&](Nui::val callback, Nui::val) -> Nui::val {
+            observerCallbacks.push_back(callback);
+            auto observer = Nui::val::object();
+            observer.set("observe", Function{[&observed](Nui::val) -> Nui::val {
+                             ++observed;
+                             return Nui::val::undefined();
+                         }});
+            observer.set("disconnect", Function{[&disconnected]() -> Nui::val {
+                             disconnected = true;
+                             return Nui::val::undefined();
+                         }});
+            return observer;
+        }};
+        globalObject.emplace("window", Object{});
+        Nui::val::global("window").set("IntersectionObserver", Nui::val{true});
+        globalObject.emplace("IntersectionObserver", intersectionObserver);
+
+        render(div{}(lazy(span{}("content"), {.whenIdle = false})));
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "div");
+        ASSERT_EQ(observerCallbacks.size(), 1);
+        EXPECT_EQ(observed, 1);
+
+        auto entry = Nui::val::object();
+        entry.set("isIntersecting", Nui::val{false});
+        auto entries = Nui::val::array();
+        entries.as<Array&>().push_back(entry.handle());
+        observerCallbacks[0](entries, Nui::val::undefined());
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "div");
+
+        entry.set("isIntersecting", Nui::val{true});
+        observerCallbacks[0](entries, Nui::val::undefined());
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "span");
+        EXPECT_TRUE(disconnected);
+    }
+
+    TEST_F(TestRender, LazyObserverIsReleasedWithItsPlaceholder)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        std::vector<Nui::val> observerCallbacks;
+        int disconnects = 0;
+        Object intersectionObserver;
+        intersectionObserver["constructor"] = Function{[&](Nui::val callback, Nui::val) -> Nui::val {
+            observerCallbacks.push_back(callback);
+            auto observer = Nui::val::object();
+            observer.set("observe", Function{[](Nui::val) -> Nui::val {
+                             return Nui::val::undefined();
+                         }});
+            observer.set("disconnect", Function{[&disconnects]() -> Nui::val {
+                             ++disconnects;
+                             return Nui::val::undefined();
+                         }});
+            return observer;
+        }};
+        globalObject.emplace("window", Object{});
+        Nui::val::global("window").set("IntersectionObserver", Nui::val{true});
+        globalObject.emplace("IntersectionObserver", intersectionObserver);
+
+        render(div{}(lazy(span{}("first"), {.whenIdle = false})));
+        ASSERT_EQ(observerCallbacks.size(), 1);
+
+        // The placeholder is gone before it ever became visible.
+        render(div{}());
+        EXPECT_EQ(disconnects, 0);
+
+        // The next lazy render drops the abandoned mount together with its observer.
+        render(div{}(lazy(span{}("second"), {.whenIdle = false})));
+        EXPECT_EQ(disconnects, 1);
+
+        auto entry = Nui::val::object();
+        entry.set("isIntersecting", Nui::val{true});
+        auto entries = Nui::val::array();
+        entries.as<Array&>().push_back(entry.handle());
+        // A late callback of the released observer finds nothing to mount.
+        observerCallbacks[0](entries, Nui::val::undefined());
+        EXPECT_EQ(disconnects, 1);
+    }
+
+    TEST_F(TestRender, RenderToHtmlSerializesTreeWithCurrentValues)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Elements::input;
+        using Nui::Attributes::class_;
+
+        Observed<std::string> text{"a < b"};
+        Observed<std::string> className{"x\"y"};
+        const auto html = renderToHtml(div{class_ = className}(
+            span{}(observe(text), [&text]() {
+                return text.value();
+            }),
+            input{}()));
+
+        EXPECT_EQ(html, "<div class=\"x&quot;y\"><span>a &lt; b</span><input></div>");
+    }
+
+    TEST_F(TestRender, RenderToHtmlCreatesNoDomNodes)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::script;
+        using Nui::Elements::span;
+        using Nui::Attributes::id;
+        using namespace Nui::StaticHtml;
+
+        Observed<bool> visible{true};
+        constexpr auto card = element<"p">(text<"static">);
+        int created = 0;
+        Nui::val::global("document").set("createElement", Function{[&created](Nui::val) -> Nui::val {
+                                              ++created;
+                                              return Nui::val::object();
+                                          }});
+        domCallCounts().clear();
+        const auto html = renderToHtml(div{id = "root"}(
+            script{}("if (a < b && c) {}"),
+            span{}(observe(visible), [&visible]() -> Nui::ElementRenderer {
+                if (visible.value())
+                    return span{}("shown");
+                return span{}("hidden");
+            }),
+            staticHtml(card),
+            lazy(span{}("deferred"))));
+
+        EXPECT_EQ(
+            html,
+            "<div id=\"root\"><script>if (a < b && c) {}</script><span><span>shown</span></span><p>static</p>"
+            "<span>deferred</span></div>");
+        EXPECT_TRUE(domCallCounts().empty());
+        EXPECT_EQ(created, 0);
+    }
+
+    TEST_F(TestRender, HydrationAdoptsExistingMarkup)
+    {
+        using Nui::Elements::body;
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::id;
+        using Nui::Attributes::onClick;
+
+        auto document = Nui::val::global("document");
+        auto existingDiv = document.call<Nui::val>("createElement", Nui::val{"DIV"});
+        existingDiv.set("marker", Nui::val{true});
+        auto existingSpan = document.call<Nui::val>("createElement", Nui::val{"SPAN"});
+        existingSpan.set("textContent", Nui::val{"text"});
+        existingSpan.set("marker", Nui::val{true});
+        existingDiv.call<void>("appendChild", existingSpan);
+        document["body"].call<void>("appendChild", existingDiv);
+
+        bool clicked = false;
+        dom_.hydrateBody(body{}(div{id = "a"}(span{onClick = [&clicked]() {
+                                                  clicked = true;
+                                              }}("text"))));
+
+        auto div0 = document["body"]["children"][0];
+        ASSERT_EQ(document["body"]["children"]["length"].as<long long>(), 1);
+        EXPECT_TRUE(div0.hasOwnProperty("marker"));
+        // Static attributes are expected to be part of the existing markup already.
+        EXPECT_FALSE(div0.hasOwnProperty("attributes"));
+        auto span0 = div0["children"][0];
+        EXPECT_TRUE(span0.hasOwnProperty("marker"));
+        EXPECT_EQ(span0["textContent"].as<std::string>(), "text");
+
+        span0["onclick"](Nui::val::object());
+        EXPECT_TRUE(clicked);
+    }
+
+    TEST_F(TestRender, HydrationRendersMismatchingPartsAnew)
+    {
+        using Nui::Elements::body;
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::class_;
+        using Nui::Attributes::id;
+
+        auto document = Nui::val::global("document");
+        auto existingDiv = document.call<Nui::val>("createElement", Nui::val{"DIV"});
+        existingDiv.set("marker", Nui::val{true});
+        auto existingP = document.call<Nui::val>("createElement", Nui::val{"P"});
+        existingP.set("marker", Nui::val{true});
+        document["body"].call<void>("appendChild", existingDiv);
+        document["body"].call<void>("appendChild", existingP);
+
+        dom_.hydrateBody(body{}(div{class_ = "adopted"}(), span{id = "created"}(div{class_ = "nested"}())));
+
+        ASSERT_EQ(document["body"]["children"]["length"].as<long long>(), 2);
+        auto div0 = document["body"]["children"][0];
+        EXPECT_TRUE(div0.hasOwnProperty("marker"));
+        EXPECT_FALSE(div0.hasOwnProperty("attributes"));
+
+        // Elements created in place of mismatching markup get their static attributes.
+        auto span1 = document["body"]["children"][1];
+        EXPECT_EQ(span1["tagName"].as<std::string>(), "span");
+        EXPECT_FALSE(span1.hasOwnProperty("marker"));
+        EXPECT_EQ(span1["attributes"]["id"].as<std::string>(), "created");
+        EXPECT_EQ(span1["children"][0]["attributes"]["class"].as<std::string>(), "nested");
+    }
+
+    TEST_F(TestRender, HydrationOfMismatchingRootSetsStaticAttributes)
+    {
+        using Nui::Elements::div;
+        using Nui::Attributes::id;
+
+        dom_.hydrateBody(div{id = "root"}());
+
+        auto root = Nui::val::global("document")["body"];
+        EXPECT_EQ(root["tagName"].as<std::string>(), "div");
+        EXPECT_EQ(root["attributes"]["id"].as<std::string>(), "root");
+    }
+
+    TEST_F(TestRender, HydrationAdoptsMarkupFromRenderToHtml)
+    {
+        using Nui::Elements::body;
+        using Nui::Elements::div;
+        using Nui::Elements::input;
+        using Nui::Elements::span;
+        using Nui::Attributes::class_;
+        using Nui::Attributes::id;
+        using Nui::Attributes::onClick;
+
+        bool clicked = false;
+        const auto page = [&clicked]() {
+            return body{}(div{id = "root", class_ = "a \"b\""}(
+                span{onClick = [&clicked]() {
+                    clicked = true;
+                }}("x < y"),
+                input{}()));
+        };
+
+        // The snapshot that would be taken at build time.
+        const auto html = renderToHtml(page());
+        ASSERT_TRUE(html.starts_with("<body>") && html.ends_with("</body>"));
+        auto markup = std::string_view{html}.substr(6, html.size() - 13);
+        auto document = Nui::val::global("document");
+        appendMarkup(document["body"], markup);
+        ASSERT_TRUE(markup.empty());
+
+        domCallCounts().clear();
+        dom_.hydrateBody(page());
+
+        EXPECT_EQ(domCallCounts().count("createElement"), 0u);
+        ASSERT_EQ(document["body"]["children"]["length"].as<long long>(), 1);
+        auto root = document["body"]["children"][0];
+        EXPECT_TRUE(root.hasOwnProperty("marker"));
+        EXPECT_EQ(root["attributes"]["class"].as<std::string>(), "a \"b\"");
+        ASSERT_EQ(root["children"]["length"].as<long long>(), 2);
+        auto text = root["children"][0];
+        EXPECT_TRUE(text.hasOwnProperty("marker"));
+        EXPECT_EQ(text["textContent"].as<std::string>(), "x < y");
+        EXPECT_TRUE(root["children"][1].hasOwnProperty("marker"));
+
+        text["onclick"](Nui::val::object());
+        EXPECT_TRUE(clicked);
+    }
+
+    TEST_F(TestRender, HydrationRemovesSurplusMarkup)
+    {
+        using Nui::Elements::body;
+        using Nui::Elements::div;
+
+        auto document = Nui::val::global("document");
+        document["body"].call<void>("appendChild", document.call<Nui::val>("createElement", Nui::val{"DIV"}));
+        document["body"].call<void>("appendChild", document.call<Nui::val>("createElement", Nui::val{"DIV"}));
+
+        dom_.hydrateBody(body{}(div{}()));
+
+        EXPECT_EQ(document["body"]["children"]["length"].as<long long>(), 1);
+    }
+
+    TEST_F(TestRender, StaticHtmlIsBuiltAtCompileTime)
+    {
+        using namespace Nui::StaticHtml;
+
+        constexpr auto header = element<"header">(
+            attribute<"class", "top \"bar\"">,
+            element<"h1">(text<"Tom & Jerry">),
+            element<"hr">(attribute<"id", "line">),
+            element<"p">());
+
+        static_assert(
+            std::string_view{header.html} ==
+            "<header class=\"top &quot;bar&quot;\"><h1>Tom &amp; Jerry</h1><hr id=\"line\"><p></p></header>");
+        static_assert(decltype(header)::size == std::string_view{header.html}.size());
+    }
+
+    TEST_F(TestRender, StaticHtmlIsInsertedInOneCall)
+    {
+        using Nui::Elements::div;
+        using namespace Nui::StaticHtml;
+
+        constexpr auto card = element<"section">(element<"span">(text<"hello">));
+        render(div{}(staticHtml(card)));
+
+        ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 1);
+        auto section = Nui::val::global("document")["body"]["children"][0];
+        EXPECT_EQ(section["tagName"].as<std::string>(), "section");
+        EXPECT_EQ(section["outerHTML"].as<std::string>(), "<section><span>hello</span></section>");
+    }
+
+    TEST_F(TestRender, MemoSkipsRenderWhenPropsAreEqual)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using namespace Nui::Attributes;
+
+        Nui::Observed<int> rebuild = 0;
+        std::string name = "a";
+        Memo<std::string> memoState;
+        int renderCount = 0;
+
+        // clang-format off
+        render(div{}(
+            observe(rebuild),
+            [&]() -> Nui::ElementRenderer {
+                return memo(memoState, name, [&renderCount](std::string const& name) -> Nui::ElementRenderer {
+                    ++renderCount;
+                    return span{id = name}();
+                });
+            }
+        ));
+        // clang-format on
+
+        EXPECT_EQ(renderCount, 1);
+
+        rebuild = 1;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renderCount, 1);
+        ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 1);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "span");
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["attributes"]["id"].as<std::string>(), "a");
+
+        name = "b";
+        rebuild = 2;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renderCount, 2);
+        ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 1);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["attributes"]["id"].as<std::string>(), "b");
+
+        memoState.reset();
+        rebuild = 3;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renderCount, 3);
+    }
+
+    TEST_F(TestRender, AsyncRenderBatchesResultsIntoOneFrame)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Elements::p;
+
+        std::vector<Nui::val> frameCallbacks;
+        globalObject.emplace("window", Object{});
+        Nui::val::global("window").set(
+            "requestAnimationFrame", Function{[&frameCallbacks](Nui::val callback) -> Nui::val {
+                frameCallbacks.push_back(callback);
+                return Nui::val{1};
+            }});
+
+        std::vector<std::function<void(std::string const&)>> resolvers;
+        AsyncSource<std::string> source = [&resolvers](AsyncHandlers<std::string> handlers) -> std::function<void()> {
+            resolvers.push_back(std::move(handlers.resolve));
+            return {};
+        };
+        auto ready = [](std::string const& text) -> Nui::ElementRenderer {
+            return span{}(text);
+        };
+
+        render(div{}(asyncRender(source, p{}("loading"), ready), asyncRender(source, p{}("loading"), ready)));
+
+        auto children = Nui::val::global("document")["body"]["children"];
+        ASSERT_EQ(children["length"].as<long long>(), 2);
+        EXPECT_EQ(children[0]["tagName"].as<std::string>(), "p");
+        ASSERT_EQ(resolvers.size(), 2);
+
+        resolvers[0]("first");
+        resolvers[1]("second");
+        EXPECT_EQ(children[0]["tagName"].as<std::string>(), "p");
+        EXPECT_EQ(children[1]["tagName"].as<std::string>(), "p");
+        ASSERT_EQ(frameCallbacks.size(), 1);
+
+        frameCallbacks[0](Nui::val{0});
+        EXPECT_EQ(children[0]["tagName"].as<std::string>(), "span");
+        EXPECT_EQ(children[0]["textContent"].as<std::string>(), "first");
+        EXPECT_EQ(children[1]["textContent"].as<std::string>(), "second");
+    }
+
+    TEST_F(TestRender, AsyncRenderCommitsImmediatelyWithoutAnimationFrames)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        globalObject.emplace("window", Object{});
+        std::function<void(int const&)> resolver;
+        AsyncSource<int> source = [&resolver](AsyncHandlers<int> handlers) -> std::function<void()> {
+            resolver = std::move(handlers.resolve);
+            return {};
+        };
+
+        render(div{}(asyncRender(source, nil(), [](int const& value) -> Nui::ElementRenderer {
+            return span{}(std::to_string(value));
+        })));
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "div");
+        resolver(42);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["tagName"].as<std::string>(), "span");
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "42");
+    }
+
+    TEST_F(TestRender, AsyncRenderCancelsSourceOfDestroyedPlaceholder)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        globalObject.emplace("window", Object{});
+        std::vector<std::function<void(int const&)>> resolvers;
+        int cancels = 0;
+        AsyncSource<int> source = [&](AsyncHandlers<int> handlers) -> std::function<void()> {
+            resolvers.push_back(std::move(handlers.resolve));
+            return [&cancels]() {
+                ++cancels;
+            };
+        };
+        auto ready = [](int const& value) -> Nui::ElementRenderer {
+            return span{}(std::to_string(value));
+        };
+
+        render(div{}(asyncRender(source, nil(), ready)));
+        ASSERT_EQ(resolvers.size(), 1);
+
+        // The placeholder is gone before the result arrived.
+        render(div{}());
+        EXPECT_EQ(cancels, 0);
+
+        // The next async render cancels the abandoned operation, the settled one is not cancelled again.
+        render(div{}(asyncRender(source, nil(), ready)));
+        EXPECT_EQ(cancels, 1);
+        resolvers[1](2);
+        render(div{}(asyncRender(source, nil(), ready)));
+        EXPECT_EQ(cancels, 1);
+    }
+
+    class TestRpcSource : public CommonTestFixture
+    {
+      protected:
+        TestRpcSource()
+        {
+            globalObject.emplace("window", Object{});
+            globalObject.emplace("nui_rpc", Object{});
+            Nui::val::global("nui_rpc").set("frontend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("backend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("tempId", 0);
+
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Test::describe", Function{[this](Nui::val requestId, Nui::val value) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    lastValue_ = value.as<long long>();
+                    return Nui::val::undefined();
+                }});
+        }
+
+        void respond(Nui::val response)
+        {
+            Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+        }
+
+        static Nui::ElementRenderer describe(int value)
+        {
+            using Nui::Elements::div;
+            using Nui::Elements::span;
+            using Nui::Elements::p;
+
+            return div{}(asyncRender(
+                rpcSource<std::string>("Test::describe", value),
+                p{}("loading"),
+                [](std::string const& text) -> Nui::ElementRenderer {
+                    return span{}(text);
+                },
+                [](std::string const& message) -> Nui::ElementRenderer {
+                    return p{}("failed: " + message);
+                }));
+        }
+
+      protected:
+        std::optional<long long> lastRequestId_{};
+        std::optional<long long> lastValue_{};
+    };
+
+    TEST_F(TestRpcSource, ResponseIsCorrelatedByRequestId)
+    {
+        const auto pendingBefore = RpcClient::pendingRequestCount();
+        render(describe(5));
+
+        ASSERT_TRUE(lastRequestId_);
+        EXPECT_EQ(lastValue_, 5);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), pendingBefore + 1);
+        EXPECT_FALSE(Nui::val::global("nui_rpc")["frontend"].hasOwnProperty("temp_1"));
+
+        auto response = Nui::val::object();
+        response.set("id", *lastRequestId_);
+        response.set("value", Nui::val{"five"});
+        respond(response);
+
+        EXPECT_EQ(RpcClient::pendingRequestCount(), pendingBefore);
+        auto placeholder = Nui::val::global("document")["body"]["children"][0];
+        EXPECT_EQ(placeholder["tagName"].as<std::string>(), "span");
+        EXPECT_EQ(placeholder["textContent"].as<std::string>(), "five");
+    }
+
+    TEST_F(TestRpcSource, ErrorRendersFailedElement)
+    {
+        render(describe(1));
+        ASSERT_TRUE(lastRequestId_);
+
+        auto response = Nui::val::object();
+        response.set("id", *lastRequestId_);
+        response.set("error", Nui::val{"boom"});
+        respond(response);
+
+        auto placeholder = Nui::val::global("document")["body"]["children"][0];
+        EXPECT_EQ(placeholder["tagName"].as<std::string>(), "p");
+        EXPECT_EQ(placeholder["textContent"].as<std::string>(), "failed: boom");
+    }
+
+    TEST_F(TestRpcSource, DestroyedPlaceholderCancelsRequest)
+    {
+        using Nui::Elements::div;
+
+        const auto pendingBefore = RpcClient::pendingRequestCount();
+        render(describe(1));
+        const auto abandonedRequestId = *lastRequestId_;
+        EXPECT_EQ(RpcClient::pendingRequestCount(), pendingBefore + 1);
+
+        render(div{}());
+        render(describe(2));
+        EXPECT_EQ(lastValue_, 2);
+        EXPECT_NE(*lastRequestId_, abandonedRequestId);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), pendingBefore + 1);
+
+        // A late response to the cancelled request is ignored, the current one still waits.
+        auto response = Nui::val::object();
+        response.set("id", abandonedRequestId);
+        response.set("value", Nui::val{"late"});
+        respond(response);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), pendingBefore + 1);
+    }
+}
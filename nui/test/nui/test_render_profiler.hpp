@@ -0,0 +1,99 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "common_test_fixture.hpp"
+#include "engine/global_object.hpp"
+#include "engine/document.hpp"
+
+#include <nui/frontend/elements.hpp>
+#include <nui/frontend/attributes.hpp>
+#include <nui/frontend/utility/render_profiler.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace Nui::Tests
+{
+    using namespace Engine;
+
+    class TestRenderProfiler : public CommonTestFixture
+    {
+      protected:
+        TestRenderProfiler()
+        {
+            RenderProfiler::clear();
+            RenderProfiler::enable();
+        }
+        ~TestRenderProfiler()
+        {
+            RenderProfiler::disable();
+            RenderProfiler::clear();
+        }
+    };
+
+    TEST_F(TestRenderProfiler, NothingIsRecordedWhenDisabled)
+    {
+        using Nui::Elements::div;
+
+        RenderProfiler::disable();
+        render(div{}(div{}()));
+
+        EXPECT_TRUE(RenderProfiler::samples().empty());
+    }
+
+    TEST_F(TestRenderProfiler, SamplesAreAttributedToComponents)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+        using Nui::Attributes::id;
+
+        render(div{}(profile("Card", div{id = "card"}(span{}("a"), span{}("b")))));
+
+        auto const& samples = RenderProfiler::samples();
+        auto component = std::find_if(samples.begin(), samples.end(), [](auto const& sample) {
+            return std::string{sample.name} == "component";
+        });
+        ASSERT_NE(component, samples.end());
+        EXPECT_EQ(component->component, "Card");
+        // div, id, two spans and their text.
+        EXPECT_EQ(component->domOperations, 6);
+
+        const auto nested = std::count_if(samples.begin(), samples.end(), [&component](auto const& sample) {
+            return sample.component == "Card" && sample.depth > component->depth;
+        });
+        EXPECT_GT(nested, 0);
+    }
+
+    TEST_F(TestRenderProfiler, ReactiveRerendersAreRecorded)
+    {
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        Observed<int> counter = 0;
+        render(div{}(observe(counter), [&counter]() -> Nui::ElementRenderer {
+            return span{}(std::to_string(*counter));
+        }));
+        RenderProfiler::clear();
+
+        counter = 1;
+        globalEventContext.executeActiveEventsImmediately();
+
+        auto const& samples = RenderProfiler::samples();
+        EXPECT_TRUE(std::any_of(samples.begin(), samples.end(), [](auto const& sample) {
+            return std::string{sample.name} == "reactiveRender";
+        }));
+    }
+
+    TEST_F(TestRenderProfiler, ExportsChromeTrace)
+    {
+        using Nui::Elements::div;
+
+        render(div{}(profile("Quote\"d", div{}())));
+
+        const auto trace = RenderProfiler::toChromeTrace();
+        EXPECT_EQ(trace.find("{\"traceEvents\":[{"), 0);
+        EXPECT_NE(trace.find("\"name\":\"Quote\\\"d\",\"cat\":\"component\",\"ph\":\"X\""), std::string::npos);
+        EXPECT_NE(trace.find("\"domOperations\":"), std::string::npos);
+    }
+}
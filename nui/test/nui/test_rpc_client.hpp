@@ -0,0 +1,113 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "common_test_fixture.hpp"
+#include "engine/global_object.hpp"
+#include "engine/function.hpp"
+#include "engine/object.hpp"
+
+#include <nui/frontend/rpc_client.hpp>
+
+#include <optional>
+#include <string>
+
+namespace Nui::Tests
+{
+    using namespace Engine;
+
+    class TestRpcClient : public CommonTestFixture
+    {
+      protected:
+        TestRpcClient()
+        {
+            globalObject.emplace("nui_rpc", Object{});
+            Nui::val::global("nui_rpc").set("frontend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("backend", Nui::val::object());
+            Nui::val::global("nui_rpc").set("tempId", 0);
+
+            Nui::val::global("nui_rpc")["backend"].set(
+                "Test::add", Function{[this](Nui::val requestId, Nui::val lhs, Nui::val rhs) -> Nui::val {
+                    lastRequestId_ = requestId.as<long long>();
+                    lastSum_ = lhs.as<long long>() + rhs.as<long long>();
+                    return Nui::val::undefined();
+                }});
+        }
+
+        void respond(Nui::val response)
+        {
+            Nui::val::global("nui_rpc")["frontend"]["Nui::rpcResponse"](response);
+        }
+
+      protected:
+        std::optional<long long> lastRequestId_{};
+        std::optional<long long> lastSum_{};
+    };
+
+    TEST_F(TestRpcClient, RequestResultIsPassedToContinuation)
+    {
+        std::optional<int> result;
+        RpcClient::getRemoteCallableWithResult("Test::add", [&result](int value) {
+            result = value;
+        })(2, 3);
+
+        ASSERT_TRUE(lastRequestId_);
+        ASSERT_TRUE(lastSum_);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 1);
+        EXPECT_FALSE(result);
+
+        auto response = Nui::val::object();
+        response.set("id", *lastRequestId_);
+        response.set("value", *lastSum_);
+        respond(response);
+
+        ASSERT_TRUE(result);
+        EXPECT_EQ(*result, 5);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 0);
+    }
+
+    TEST_F(TestRpcClient, RequestsDoNotCreateTemporaryFunctions)
+    {
+        for (int i = 0; i != 3; ++i)
+            RpcClient::getRemoteCallableWithResult("Test::add", [](int) {})(i, i);
+
+        auto frontend = Nui::val::global("nui_rpc")["frontend"];
+        EXPECT_TRUE(frontend.hasOwnProperty("Nui::rpcResponse"));
+        EXPECT_EQ(frontend.as<Object const&>().size(), 1);
+        EXPECT_EQ(Nui::val::global("nui_rpc")["tempId"].as<long long>(), 0);
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 3);
+
+        // Ids are numeric and distinct.
+        for (long long id = *lastRequestId_ - 2; id <= *lastRequestId_; ++id)
+        {
+            auto response = Nui::val::object();
+            response.set("id", id);
+            response.set("value", 0);
+            respond(response);
+        }
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 0);
+    }
+
+    TEST_F(TestRpcClient, ErrorIsPassedToErrorHandler)
+    {
+        bool resultCalled = false;
+        std::string error;
+        RpcClient::getRemoteCallableWithResult(
+            "Test::add",
+            [&resultCalled](int) {
+                resultCalled = true;
+            },
+            [&error](std::string const& message) {
+                error = message;
+            })(1, 1);
+
+        auto response = Nui::val::object();
+        response.set("id", *lastRequestId_);
+        response.set("error", std::string{"file not found"});
+        respond(response);
+
+        EXPECT_FALSE(resultCalled);
+        EXPECT_EQ(error, "file not found");
+        EXPECT_EQ(RpcClient::pendingRequestCount(), 0);
+    }
+}
@@ -59,4 +59,92 @@ namespace Nui::Tests
 
         EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "Default");
     }
-}
\ No newline at end of file
+
+    TEST_F(TestSwitch, KeepAliveReattachesInactiveBranches)
+    {
+        using namespace Nui::Elements;
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        int aRenders = 0;
+        int bRenders = 0;
+        auto counted = [](int& counter, std::string text) -> Nui::ElementRenderer {
+            return [&counter, renderer = Nui::ElementRenderer{span{}(std::move(text))}](
+                       Dom::Element& parent, Renderer const& gen) {
+                ++counter;
+                return renderer(parent, gen);
+            };
+        };
+
+        // clang-format off
+        render(div{}(
+            switch_(urlFragment_, SwitchOptions{.keepAlive = 2})(
+                case_("")(
+                    counted(aRenders, "A")
+                ),
+                case_("b")(
+                    counted(bRenders, "B")
+                )
+            )
+        ));
+        // clang-format on
+
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "A");
+
+        urlFragment_ = "b"s;
+        globalEventContext.executeActiveEventsImmediately();
+        ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 1);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "B");
+
+        urlFragment_ = ""s;
+        globalEventContext.executeActiveEventsImmediately();
+        urlFragment_ = "b"s;
+        globalEventContext.executeActiveEventsImmediately();
+
+        ASSERT_EQ(Nui::val::global("document")["body"]["children"]["length"].as<long long>(), 1);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "B");
+        EXPECT_EQ(aRenders, 1);
+        EXPECT_EQ(bRenders, 1);
+    }
+
+    TEST_F(TestSwitch, KeepAliveEvictsLeastRecentlyUsedBranch)
+    {
+        using namespace Nui::Elements;
+        using Nui::Elements::div;
+        using Nui::Elements::span;
+
+        int renders = 0;
+        auto counted = [&renders](std::string text) -> Nui::ElementRenderer {
+            return [&renders, renderer = Nui::ElementRenderer{span{}(std::move(text))}](
+                       Dom::Element& parent, Renderer const& gen) {
+                ++renders;
+                return renderer(parent, gen);
+            };
+        };
+
+        // clang-format off
+        render(div{}(
+            switch_(urlFragment_, SwitchOptions{.keepAlive = 1})(
+                case_("")(counted("A")),
+                case_("b")(counted("B")),
+                case_("c")(counted("C"))
+            )
+        ));
+        // clang-format on
+
+        urlFragment_ = "b"s;
+        globalEventContext.executeActiveEventsImmediately();
+        urlFragment_ = "c"s;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renders, 3);
+
+        // "b" is still cached, "" was evicted.
+        urlFragment_ = "b"s;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renders, 3);
+        urlFragment_ = ""s;
+        globalEventContext.executeActiveEventsImmediately();
+        EXPECT_EQ(renders, 4);
+        EXPECT_EQ(Nui::val::global("document")["body"]["children"][0]["textContent"].as<std::string>(), "A");
+    }
+}
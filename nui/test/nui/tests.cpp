@@ -1,10 +1,16 @@
 #include "test_attributes.hpp"
+#include "test_fetch.hpp"
+#include "test_file.hpp"
+#include "test_mpsc_queue.hpp"
 #include "test_ranges.hpp"
 #include "test_render.hpp"
+#include "test_render_profiler.hpp"
+#include "test_rpc_client.hpp"
 #include "test_switch.hpp"
 #include "components/test_table.hpp"
 #include "components/test_dialog.hpp"
 #include "components/test_select.hpp"
+#include "components/test_text_input.hpp"
 
 #include <gtest/gtest.h>
 
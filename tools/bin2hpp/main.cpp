@@ -1,13 +1,117 @@
+#include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <ios>
 #include <iostream>
 #include <iomanip>
 #include <string>
 #include <filesystem>
+#include <vector>
 
 constexpr std::size_t lineWidth = 120;
 
+/**
+ * Embeds every file of a directory as one string literal each, so that they can be served without copying them. The
+ * generated function returns the files for Nui::Window::setVirtualHostNameToEmbeddedFiles. MSVC limits concatenated
+ * literals to 64 KiB, larger files need GCC or Clang.
+ */
+int writeDirectory(std::filesystem::path const& inputDirectory, std::string const& outputFile, std::string const& name)
+{
+    std::vector<std::filesystem::path> files;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(inputDirectory))
+    {
+        if (entry.is_regular_file())
+            files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::ofstream output(outputFile, std::ios_base::binary);
+    if (!output.is_open())
+    {
+        std::cout << "Could not open file \"" << outputFile << "\"\n";
+        return 1;
+    }
+
+    output << "#pragma once\n";
+    output << "\n";
+    output << "#include <nui/backend/embedded_file.hpp>\n";
+    output << "\n";
+    output << "#include <span>\n";
+    output << "\n";
+
+    std::vector<std::uintmax_t> sizes;
+    for (std::size_t index = 0; index != files.size(); ++index)
+    {
+        std::ifstream input(files[index], std::ios_base::binary);
+        if (!input.is_open())
+        {
+            std::cout << "Could not open file \"" << files[index].string() << "\"\n";
+            return 1;
+        }
+
+        // One literal per file, split over lines. Adjacent literals are concatenated, so the file stays contiguous,
+        // and literals are parsed far faster than a list of numbers.
+        output << "static const char " << name << "_file" << index << "[] =\n\t\"";
+        std::uintmax_t size = 0;
+        std::size_t widthUsed = 0;
+        do
+        {
+            char buffer[4096];
+            input.read(buffer, sizeof(buffer));
+            for (std::streamsize i = 0; i != input.gcount(); ++i)
+            {
+                const auto c = static_cast<unsigned char>(buffer[i]);
+                // '?' as well, so that no trigraph is formed.
+                const bool escape = c < 32 || c >= 127 || c == '"' || c == '\\' || c == '?';
+                if (widthUsed + (escape ? 4 : 1) > lineWidth - 4)
+                {
+                    output << "\"\n\t\"";
+                    widthUsed = 0;
+                }
+                // Always three octal digits, a digit that follows can not become part of the escape.
+                if (escape)
+                    output << '\\' << std::oct << std::setw(3) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    output << static_cast<char>(c);
+                widthUsed += escape ? 4 : 1;
+                ++size;
+            }
+        } while (input.gcount() > 0);
+        output << "\";\n";
+        sizes.push_back(size);
+    }
+
+    output << "\n";
+    output << "static std::span<Nui::EmbeddedFile const> " << name << "()\n";
+    output << "{\n";
+    if (files.empty())
+    {
+        output << "\treturn {};\n";
+        output << "}\n";
+        return 0;
+    }
+    output << "\tstatic const Nui::EmbeddedFile files[] = {\n";
+    for (std::size_t index = 0; index != files.size(); ++index)
+    {
+        const auto path = "/" + std::filesystem::relative(files[index], inputDirectory).generic_string();
+        output << "\t\t{\"";
+        for (const char c : path)
+        {
+            if (c < 32 || c == '"' || c == '\\')
+                output << '\\' << std::oct << std::setw(3) << std::setfill('0')
+                       << static_cast<int>(static_cast<unsigned char>(c)) << std::dec;
+            else
+                output << c;
+        }
+        output << "\", {" << name << "_file" << index << ", " << sizes[index] << "}},\n";
+    }
+    output << "\t};\n";
+    output << "\treturn files;\n";
+    output << "}\n";
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
     if (argc != 5)
@@ -15,6 +119,7 @@ int main(int argc, char** argv)
         std::cout << "Expected 4 arguments: <yes/no> <input file> <output file> <name>, but got " << argc - 1 << "\n";
         std::cout << "Usage: " << argv[0] << " <yes/no> <input file> <output file> <name>"
                   << "\n";
+        std::cout << "If the input is a directory, all files in it are embedded." << "\n";
         return 1;
     }
 
@@ -32,6 +137,9 @@ int main(int argc, char** argv)
     if (!std::filesystem::exists(outputPath))
         std::filesystem::create_directories(outputPath);
 
+    if (std::filesystem::is_directory(inputFile))
+        return writeDirectory(inputFile, outputFile, name);
+
     std::ifstream input(inputFile, std::ios_base::binary);
     std::ofstream output(outputFile, std::ios_base::binary);
     if (!input.is_open())